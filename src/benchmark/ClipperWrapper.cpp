@@ -65,4 +65,24 @@ double BenchmarkUnion(const Polygon &poly1, const Polygon &poly2, Polygon &resul
 	return std::chrono::duration<double>(t2 - t1).count() / double(loops);
 }
 
+double BenchmarkOffset(const Polygon &poly, double distance, Polygon &result, size_t loops) {
+
+	// import
+	ClipperLib::Polygons a, c;
+	PolyToClipper(poly, a);
+
+	// benchmark (same arc tolerance as PolyMath)
+	auto t1 = std::chrono::high_resolution_clock::now();
+	for(size_t loop = 0; loop < loops; ++loop) {
+		c.clear();
+		ClipperLib::OffsetPolygons(a, c, distance * CLIPPER_SCALE, ClipperLib::jtRound, std::fabs(distance) * 0.002 * CLIPPER_SCALE);
+	}
+	auto t2 = std::chrono::high_resolution_clock::now();
+
+	// export
+	PolyFromClipper(c, result);
+
+	return std::chrono::duration<double>(t2 - t1).count() / double(loops);
+}
+
 }
@@ -7,5 +7,6 @@ namespace ClipperWrapper {
 using namespace Wrappers;
 
 double BenchmarkUnion(const Polygon &poly1, const Polygon &poly2, Polygon &result, size_t loops);
+double BenchmarkOffset(const Polygon &poly, double distance, Polygon &result, size_t loops);
 
 };
@@ -24,6 +24,30 @@ struct Benchmark {
 	bool m_run;
 };
 
+struct OffsetBenchmark {
+	std::string m_name;
+	double (*m_func)(const TestGenerators::Polygon&, double, TestGenerators::Polygon&, size_t);
+	bool m_run;
+};
+
+struct StrokeBenchmark {
+	std::string m_name;
+	double (*m_func)(const TestGenerators::Polyline&, double, TestGenerators::Polygon&, size_t);
+	bool m_run;
+};
+
+// runs the function repeatedly until at least one second has passed, returns the time per run
+template<typename Func>
+double RunTimed(Func &&func) {
+	size_t loops = 1;
+	for( ; ; ) {
+		double time = func(loops);
+		if(time * double(loops) > 1.0)
+			return time;
+		loops = std::max(loops + 1, size_t(1.5 / time));
+	}
+}
+
 int main(int argc, char *argv[]) {
 	POLYMATH_UNUSED(argc);
 	POLYMATH_UNUSED(argv);
@@ -41,7 +65,7 @@ int main(int argc, char *argv[]) {
 		{"Boost F32"   , BoostWrapper   ::BenchmarkUnion_F32, true},
 		//{"Boost F64"   , BoostWrapper   ::BenchmarkUnion_F64, true},
 #endif
-#if BENCHMARK_WITH_BOOST
+#if BENCHMARK_WITH_CLIPPER
 		{"Clipper"     , ClipperWrapper ::BenchmarkUnion    , true},
 #endif
 #if BENCHMARK_WITH_GEOS
@@ -72,13 +96,9 @@ int main(int argc, char *argv[]) {
 			TestGenerators::Polygon result;
 			double time = 0.0;
 			if(benchmark.m_run) {
-				size_t loops = 1;
-				for( ; ; ) {
-					time = benchmark.m_func(inputs[0], inputs[1], result, loops);
-					if(time * double(loops) > 1.0)
-						break;
-					loops = std::max(loops + 1, size_t(1.5 / time));
-				}
+				time = RunTimed([&](size_t loops) {
+					return benchmark.m_func(inputs[0], inputs[1], result, loops);
+				});
 				benchmark.m_run = (time < 10.0);
 			}
 			std::cout << W << time;
@@ -88,6 +108,94 @@ int main(int argc, char *argv[]) {
 		std::cout << std::endl;
 
 	}
+
+	// offset benchmark (round joins, the distance is a fraction of the grid size)
+	std::vector<OffsetBenchmark> offset_benchmarks = {
+		{"PolyMath I32", PolyMathWrapper::BenchmarkOffset_I32, true},
+		{"PolyMath F32", PolyMathWrapper::BenchmarkOffset_F32, true},
+#if BENCHMARK_WITH_CLIPPER
+		{"Clipper"     , ClipperWrapper ::BenchmarkOffset   , true},
+#endif
+	};
+
+	std::cout << W << "Offset" << W << "Vertices";
+	for(OffsetBenchmark &benchmark : offset_benchmarks) {
+		std::cout << W << benchmark.m_name;
+	}
+	std::cout << std::endl;
+
+	for(size_t tnum = 0; tnum < tests.size(); ++tnum) {
+
+		std::cout << W << tests[tnum];
+		std::cout.flush();
+
+		TestGenerators::Polygon inputs[2];
+		TestGenerators::DualGrid(0, TestGenerators::DUALGRID_DEFAULT, tests[tnum], 20.0, false, inputs);
+		double distance = 0.2 / double(tests[tnum]);
+
+		std::cout << W << inputs[0].vertices.size();
+		std::cout.flush();
+
+		for(OffsetBenchmark &benchmark : offset_benchmarks) {
+			TestGenerators::Polygon result;
+			double time = 0.0;
+			if(benchmark.m_run) {
+				time = RunTimed([&](size_t loops) {
+					return benchmark.m_func(inputs[0], distance, result, loops);
+				});
+				benchmark.m_run = (time < 10.0);
+			}
+			std::cout << W << time;
+			std::cout.flush();
+		}
+
+		std::cout << std::endl;
+
+	}
+	// stroke benchmark (round joins and caps, 100 segments per path, the density is the same for all sizes)
+	std::vector<StrokeBenchmark> stroke_benchmarks = {
+		{"PolyMath I32", PolyMathWrapper::BenchmarkStroke_I32, true},
+		{"PolyMath F32", PolyMathWrapper::BenchmarkStroke_F32, true},
+		{"Segments F32", PolyMathWrapper::BenchmarkStrokeSegments_F32, true},
+	};
+
+	std::cout << W << "Stroke" << W << "Segments";
+	for(StrokeBenchmark &benchmark : stroke_benchmarks) {
+		std::cout << W << benchmark.m_name;
+	}
+	std::cout << std::endl;
+
+	std::vector<uint32_t> stroke_tests = {1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000, 10000};
+	for(size_t tnum = 0; tnum < stroke_tests.size(); ++tnum) {
+
+		std::cout << W << stroke_tests[tnum];
+		std::cout.flush();
+
+		uint32_t segments = stroke_tests[tnum] * 100;
+		double segment_length = 1.0 / std::sqrt(double(segments));
+		TestGenerators::Polyline input = TestGenerators::Traces(0, stroke_tests[tnum], 100, segment_length);
+		double width = 0.2 * segment_length;
+
+		std::cout << W << segments;
+		std::cout.flush();
+
+		for(StrokeBenchmark &benchmark : stroke_benchmarks) {
+			TestGenerators::Polygon result;
+			double time = 0.0;
+			if(benchmark.m_run) {
+				time = RunTimed([&](size_t loops) {
+					return benchmark.m_func(input, width, result, loops);
+				});
+				benchmark.m_run = (time < 10.0);
+			}
+			std::cout << W << time;
+			std::cout.flush();
+		}
+
+		std::cout << std::endl;
+
+	}
+
 	std::cout << "Done." << std::endl;
 
 	return 0;
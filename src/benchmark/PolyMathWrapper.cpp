@@ -13,6 +13,7 @@ struct Conversion {
 
 	typedef PolyMath::Vertex<T> Vertex2;
 	typedef PolyMath::Polygon<T> Polygon2;
+	typedef PolyMath::Polyline<T> Polyline2;
 
 	static double BenchmarkUnion(const Polygon &poly1, const Polygon &poly2, Polygon &result, size_t loops) {
 
@@ -26,7 +27,7 @@ struct Conversion {
 		for(size_t loop = 0; loop < loops; ++loop) {
 			PolyMath::SweepEngine<T, PolyMath::OutputPolicy_Simple<T>, PolyMath::WindingPolicy_Positive<>> engine(ab);
 			engine.Process();
-			c = engine.Result();
+			engine.ResultInto(c);
 		}
 		auto t2 = std::chrono::high_resolution_clock::now();
 
@@ -48,7 +49,96 @@ struct Conversion {
 		for(size_t loop = 0; loop < loops; ++loop) {
 			PolyMath::SweepEngine<T, PolyMath::OutputPolicy_Simple<T>, PolyMath::WindingPolicy_Positive<>, PolyMath::SweepTree_Basic2> engine(ab);
 			engine.Process();
-			c = engine.Result();
+			engine.ResultInto(c);
+		}
+		auto t2 = std::chrono::high_resolution_clock::now();
+
+		// export
+		result = TestGenerators::TypeConverter<T>::ConvertPolygonFromType(c);
+
+		return std::chrono::duration<double>(t2 - t1).count() / double(loops);
+	}
+
+	static double BenchmarkOffset(const Polygon &poly, double distance, Polygon &result, size_t loops) {
+
+		// import
+		Polygon2 a, c;
+		a = TestGenerators::TypeConverter<T>::ConvertPolygonToType(poly);
+		double distance2 = distance * TestGenerators::TypeConverter<T>::ScaleFactor();
+
+		// benchmark
+		auto t1 = std::chrono::high_resolution_clock::now();
+		for(size_t loop = 0; loop < loops; ++loop) {
+			c = PolyMath::PolygonOffset(a, distance2, PolyMath::OFFSETJOIN_ROUND);
+		}
+		auto t2 = std::chrono::high_resolution_clock::now();
+
+		// export
+		result = TestGenerators::TypeConverter<T>::ConvertPolygonFromType(c);
+
+		return std::chrono::duration<double>(t2 - t1).count() / double(loops);
+	}
+
+	static double BenchmarkStroke(const Polyline &polyline, double width, Polygon &result, size_t loops) {
+
+		// import
+		Polyline2 a;
+		Polygon2 c;
+		a = TestGenerators::TypeConverter<T>::ConvertPolylineToType(polyline);
+		double width2 = width * TestGenerators::TypeConverter<T>::ScaleFactor();
+
+		// benchmark
+		auto t1 = std::chrono::high_resolution_clock::now();
+		for(size_t loop = 0; loop < loops; ++loop) {
+			c = PolyMath::PolylineStroke(a, width2, PolyMath::OFFSETJOIN_ROUND, PolyMath::STROKECAP_ROUND);
+		}
+		auto t2 = std::chrono::high_resolution_clock::now();
+
+		// export
+		result = TestGenerators::TypeConverter<T>::ConvertPolygonFromType(c);
+
+		return std::chrono::duration<double>(t2 - t1).count() / double(loops);
+	}
+
+	// the old approach: one quad per segment and one disc per vertex, concatenated and unioned
+	static double BenchmarkStrokeSegments(const Polyline &polyline, double width, Polygon &result, size_t loops) {
+
+		// import
+		Polyline2 a;
+		Polygon2 b, c;
+		a = TestGenerators::TypeConverter<T>::ConvertPolylineToType(polyline);
+		double distance = 0.5 * width * TestGenerators::TypeConverter<T>::ScaleFactor();
+		size_t disc_steps = size_t(std::ceil(2.0 * M_PI / PolyMath::PolygonOffsetStepAngle(distance, distance * 0.002)));
+
+		// benchmark
+		auto t1 = std::chrono::high_resolution_clock::now();
+		for(size_t loop = 0; loop < loops; ++loop) {
+			b.Clear();
+			for(size_t i = 0; i < a.path_ends.size(); ++i) {
+				const Vertex2 *vertices = a.GetPathVertices(i);
+				size_t n = a.GetPathVertexCount(i);
+				for(size_t j = 0; j < n; ++j) {
+					double x = double(vertices[j].x), y = double(vertices[j].y);
+					for(size_t k = 0; k < disc_steps; ++k) {
+						double angle = 2.0 * M_PI * double(k) / double(disc_steps);
+						b.AddVertex(Vertex2(PolyMath::ConvertFromDouble<T>(x + std::cos(angle) * distance), PolyMath::ConvertFromDouble<T>(y + std::sin(angle) * distance)));
+					}
+					b.AddLoopEnd(1);
+					if(j != n - 1) {
+						double dx = double(vertices[j + 1].x) - x, dy = double(vertices[j + 1].y) - y;
+						double scale = distance / std::hypot(dx, dy);
+						double nx = dy * scale, ny = -dx * scale;
+						b.AddVertex(Vertex2(PolyMath::ConvertFromDouble<T>(x + nx), PolyMath::ConvertFromDouble<T>(y + ny)));
+						b.AddVertex(Vertex2(PolyMath::ConvertFromDouble<T>(x + dx + nx), PolyMath::ConvertFromDouble<T>(y + dy + ny)));
+						b.AddVertex(Vertex2(PolyMath::ConvertFromDouble<T>(x + dx - nx), PolyMath::ConvertFromDouble<T>(y + dy - ny)));
+						b.AddVertex(Vertex2(PolyMath::ConvertFromDouble<T>(x - nx), PolyMath::ConvertFromDouble<T>(y - ny)));
+						b.AddLoopEnd(1);
+					}
+				}
+			}
+			PolyMath::SweepEngine<T, PolyMath::OutputPolicy_Simple<T>, PolyMath::WindingPolicy_Positive<>> engine(b);
+			engine.Process();
+			engine.ResultInto(c);
 		}
 		auto t2 = std::chrono::high_resolution_clock::now();
 
@@ -70,4 +160,13 @@ double BenchmarkUnion_F64(const Polygon &poly1, const Polygon &poly2, Polygon &r
 double BenchmarkUnion_S1(const Polygon &poly1, const Polygon &poly2, Polygon &result, size_t loops) { return Conversion<float>::BenchmarkUnion(poly1, poly2, result, loops); }
 double BenchmarkUnion_S2(const Polygon &poly1, const Polygon &poly2, Polygon &result, size_t loops) { return Conversion<float>::BenchmarkUnion2(poly1, poly2, result, loops); }
 
+
+double BenchmarkOffset_I32(const Polygon &poly, double distance, Polygon &result, size_t loops) { return Conversion<int32_t>::BenchmarkOffset(poly, distance, result, loops); }
+double BenchmarkOffset_F32(const Polygon &poly, double distance, Polygon &result, size_t loops) { return Conversion<float>::BenchmarkOffset(poly, distance, result, loops); }
+
+
+double BenchmarkStroke_I32(const Polyline &polyline, double width, Polygon &result, size_t loops) { return Conversion<int32_t>::BenchmarkStroke(polyline, width, result, loops); }
+double BenchmarkStroke_F32(const Polyline &polyline, double width, Polygon &result, size_t loops) { return Conversion<float>::BenchmarkStroke(polyline, width, result, loops); }
+double BenchmarkStrokeSegments_F32(const Polyline &polyline, double width, Polygon &result, size_t loops) { return Conversion<float>::BenchmarkStrokeSegments(polyline, width, result, loops); }
+
 }
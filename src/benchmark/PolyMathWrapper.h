@@ -16,4 +16,11 @@ double BenchmarkUnion_F64(const Polygon &poly1, const Polygon &poly2, Polygon &r
 double BenchmarkUnion_S1(const Polygon &poly1, const Polygon &poly2, Polygon &result, size_t loops);
 double BenchmarkUnion_S2(const Polygon &poly1, const Polygon &poly2, Polygon &result, size_t loops);
 
+double BenchmarkOffset_I32(const Polygon &poly, double distance, Polygon &result, size_t loops);
+double BenchmarkOffset_F32(const Polygon &poly, double distance, Polygon &result, size_t loops);
+
+double BenchmarkStroke_I32(const Polyline &polyline, double width, Polygon &result, size_t loops);
+double BenchmarkStroke_F32(const Polyline &polyline, double width, Polygon &result, size_t loops);
+double BenchmarkStrokeSegments_F32(const Polyline &polyline, double width, Polygon &result, size_t loops);
+
 };
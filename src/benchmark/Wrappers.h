@@ -6,5 +6,6 @@ namespace Wrappers {
 
 typedef PolyMath::Vertex<double> Vertex;
 typedef PolyMath::Polygon<double> Polygon;
+typedef PolyMath::Polyline<double> Polyline;
 
 }
@@ -124,6 +124,10 @@ void MainLoop() {
 	bool wireframe = true;
 	uint32_t prev_time = SDL_GetTicks();
 
+	// these are reused for every frame to avoid memory allocations
+	Polygon poly, triangles;
+	PolyMath::SweepEngine<float, PolyMath::OutputPolicy_Triangles<float>, PolyMath::WindingPolicy_Positive<>, PolyMath::SweepTree_Basic2> engine;
+
 	float fps_current;
 	uint32_t fps_frames = 0;
 	uint32_t fps_lasttime = prev_time;
@@ -200,7 +204,7 @@ void MainLoop() {
 		float ww = float(w), hh = float(h);
 		float scale = sqrt(float(w) * float(h));
 		float delta_time = 0.001f * float(curr_time - prev_time);
-		Polygon poly;
+		poly.Clear();
 		for(Gear &gear : g_gears) {
 			gear.cx += gear.vx * delta_time;
 			gear.cy += gear.vy * delta_time;
@@ -225,12 +229,9 @@ void MainLoop() {
 		}
 
 		// triangulate
-		Polygon triangles;
-		{
-			PolyMath::SweepEngine<float, PolyMath::OutputPolicy_Triangles<float>, PolyMath::WindingPolicy_Positive<>, PolyMath::SweepTree_Basic2> engine(poly);
-			engine.Process();
-			triangles = engine.Result();
-		}
+		engine.Reset(poly);
+		engine.Process();
+		engine.ResultInto(triangles);
 
 		// draw triangles
 		glEnableClientState(GL_VERTEX_ARRAY);
@@ -5,6 +5,9 @@
 #include <cstddef>
 #include <cstdint>
 
+#include <algorithm>
+#include <limits>
+#include <type_traits>
 #include <vector>
 
 #define POLYMATH_UNUSED(x) ((void) (x))
@@ -27,4 +30,29 @@ F Square(F x) {
 	return x * x;
 }
 
+// Converts a calculated coordinate back to the vertex type (rounded and clamped for integers). The numerical engine
+// calculates differences of coordinates in the vertex type itself, so integer coordinates are clamped to half the range
+// of the type. The clamping is done after rounding, so values just below the limit can't overflow.
+template<typename T>
+typename std::enable_if<std::is_integral<T>::value, T>::type ConvertFromDouble(double x) {
+	constexpr T low = std::numeric_limits<T>::min() / 2, high = std::numeric_limits<T>::max() / 2;
+	double r = std::rint(x);
+	return (r <= double(low))? low : (r >= double(high))? high : T(r);
+}
+template<typename T>
+typename std::enable_if<std::is_floating_point<T>::value, T>::type ConvertFromDouble(double x) {
+	return T(x);
+}
+
+// Returns the maximum error introduced by ConvertFromDouble for coordinates up to the given magnitude.
+template<typename T>
+typename std::enable_if<std::is_integral<T>::value, double>::type ConversionError(double magnitude) {
+	POLYMATH_UNUSED(magnitude);
+	return 0.5;
+}
+template<typename T>
+typename std::enable_if<std::is_floating_point<T>::value, double>::type ConversionError(double magnitude) {
+	return 0.5 * double(std::numeric_limits<T>::epsilon()) * std::max(magnitude, double(std::numeric_limits<T>::min()));
+}
+
 }
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Common.h"
+
+#include "Vertex.h"
+
+namespace PolyMath {
+
+// Half-edge (doubly connected edge list) representation of the output of a polygon operation. Every edge is
+// represented by two half-edges which are each other's twin. The face of a half-edge is always on its left side,
+// so the outer boundary of a face runs counterclockwise and the boundaries of its holes run clockwise. Face 0 is
+// the unbounded face, which has no outer boundary.
+template<typename T>
+struct HalfEdgeMesh {
+
+	typedef T ValueType;
+	typedef Vertex<T> VertexType;
+
+	struct MeshVertex {
+		VertexType position;
+		size_t half_edge; // one of the outgoing half-edges
+	};
+
+	struct HalfEdge {
+		size_t origin, twin, next, prev, face;
+	};
+
+	struct Face {
+		size_t outer_half_edge; // INDEX_NONE for the unbounded face
+		size_t inner_end; // end of the inner components of this face in inner_half_edges
+		bool filled;
+	};
+
+	std::vector<MeshVertex> vertices;
+	std::vector<HalfEdge> half_edges;
+	std::vector<Face> faces;
+	std::vector<size_t> inner_half_edges; // one half-edge for each inner component, grouped by face
+
+	void Clear() {
+		vertices.clear();
+		half_edges.clear();
+		faces.clear();
+		inner_half_edges.clear();
+	}
+
+	size_t GetDestination(size_t i) const {
+		assert(i < half_edges.size());
+		return half_edges[half_edges[i].twin].origin;
+	}
+
+	size_t GetOppositeFace(size_t i) const {
+		assert(i < half_edges.size());
+		return half_edges[half_edges[i].twin].face;
+	}
+
+	const size_t* GetFaceInnerHalfEdges(size_t i) const {
+		assert(i < faces.size());
+		return (i == 0)? inner_half_edges.data() : inner_half_edges.data() + faces[i - 1].inner_end;
+	}
+	size_t GetFaceInnerCount(size_t i) const {
+		assert(i < faces.size());
+		return (i == 0)? faces[i].inner_end : faces[i].inner_end - faces[i - 1].inner_end;
+	}
+
+};
+
+}
@@ -6,6 +6,103 @@
 
 namespace PolyMath {
 
+// A 256-bit signed integer that is used to calculate exact sums of (products of) coordinates.
+struct Accumulator_Int {
+
+	uint64_t v0, v1, v2;
+	int64_t v3;
+
+	Accumulator_Int() : v0(0), v1(0), v2(0), v3(0) {}
+
+	void Add_128(uint64_t x0, int64_t x1) {
+		uint64_t s = uint64_t(x1 >> 63);
+		WideMath::Add_256(v0, v1, v2, v3, x0, uint64_t(x1), s, int64_t(s), v0, v1, v2, v3);
+	}
+
+	void Add_192(uint64_t x0, uint64_t x1, int64_t x2) {
+		WideMath::Add_256(v0, v1, v2, v3, x0, x1, uint64_t(x2), x2 >> 63, v0, v1, v2, v3);
+	}
+
+	double ToDouble() const {
+		// convert the absolute value to avoid cancellation
+		uint64_t s = uint64_t(v3 >> 63);
+		uint64_t a0, a1, a2, a3;
+		WideMath::Subtract_256(v0 ^ s, v1 ^ s, v2 ^ s, uint64_t(v3) ^ s, s, s, s, s, a0, a1, a2, a3);
+		double res = std::ldexp(double(a3), 192) + std::ldexp(double(a2), 128) + std::ldexp(double(a1), 64) + double(a0);
+		return (s)? -res : res;
+	}
+
+	void Add(const Accumulator_Int &other) {
+		WideMath::Add_256(v0, v1, v2, v3, other.v0, other.v1, other.v2, other.v3, v0, v1, v2, v3);
+	}
+
+	bool IsZero() const {
+		return ((v0 | v1 | v2 | uint64_t(v3)) == 0);
+	}
+
+	// Adds the contribution of the edge (a, b) to the area and the first moments of area (all scaled by a constant factor).
+	static void AccumulateEdge(int64_t a_x, int64_t a_y, int64_t b_x, int64_t b_y, Accumulator_Int &area, Accumulator_Int &moment_x, Accumulator_Int &moment_y) {
+		uint64_t cross0, lhs0, rhs0;
+		int64_t cross1, lhs1, rhs1;
+		WideMath::Multiply_64x64_128(a_x, b_y, lhs0, lhs1);
+		WideMath::Multiply_64x64_128(a_y, b_x, rhs0, rhs1);
+		WideMath::Subtract_128(lhs0, lhs1, rhs0, rhs1, cross0, cross1);
+		area.Add_128(cross0, cross1);
+		uint64_t mx0, mx1, my0, my1;
+		int64_t mx2, my2;
+		WideMath::Multiply_128x64_192(cross0, cross1, a_x + b_x, mx0, mx1, mx2);
+		WideMath::Multiply_128x64_192(cross0, cross1, a_y + b_y, my0, my1, my2);
+		moment_x.Add_192(mx0, mx1, mx2);
+		moment_y.Add_192(my0, my1, my2);
+	}
+
+	// Adds the contribution of the edge (a, b) to the area only.
+	static void AccumulateArea(int64_t a_x, int64_t a_y, int64_t b_x, int64_t b_y, Accumulator_Int &area) {
+		uint64_t cross0, lhs0, rhs0;
+		int64_t cross1, lhs1, rhs1;
+		WideMath::Multiply_64x64_128(a_x, b_y, lhs0, lhs1);
+		WideMath::Multiply_64x64_128(a_y, b_x, rhs0, rhs1);
+		WideMath::Subtract_128(lhs0, lhs1, rhs0, rhs1, cross0, cross1);
+		area.Add_128(cross0, cross1);
+	}
+
+};
+
+// The floating point equivalent of Accumulator_Int.
+template<typename F2>
+struct Accumulator_Float {
+
+	F2 v;
+
+	Accumulator_Float() : v(0) {}
+
+	double ToDouble() const {
+		return double(v);
+	}
+
+	void Add(const Accumulator_Float &other) {
+		v += other.v;
+	}
+
+	bool IsZero() const {
+		return (v == F2(0));
+	}
+
+	// Adds the contribution of the edge (a, b) to the area and the first moments of area (all scaled by a constant factor).
+	static void AccumulateEdge(F2 a_x, F2 a_y, F2 b_x, F2 b_y, Accumulator_Float &area, Accumulator_Float &moment_x, Accumulator_Float &moment_y) {
+		F2 cross = a_x * b_y - a_y * b_x;
+		area.v += cross;
+		moment_x.v += (a_x + b_x) * cross;
+		moment_y.v += (a_y + b_y) * cross;
+	}
+
+	// Adds the contribution of the edge (a, b) to the area only.
+	static void AccumulateArea(F2 a_x, F2 a_y, F2 b_x, F2 b_y, Accumulator_Float &area) {
+		area.v += a_x * b_y - a_y * b_x;
+	}
+
+};
+
 template<int bits, typename I1, typename I2, typename I4>
 struct NumericalEngine_Int {
 
@@ -29,6 +126,33 @@ struct NumericalEngine_Int {
 		return (strict)? (lhs > rhs) : (lhs >= rhs);
 	}
 
+	// Returns whether d lies inside the circle through a, b and c, which must be ordered such that OrientationTest(a, b, c)
+	// returns true. If strict is false, points on the circle are also accepted. This requires a determinant of degree 4,
+	// which is evaluated as (t1 + t2 >= -t3) so that the intermediate results don't overflow.
+	static bool InCircleTest(I1 a_x, I1 a_y, I1 b_x, I1 b_y, I1 c_x, I1 c_y, I1 d_x, I1 d_y, bool strict) {
+		I2 adx = I2(a_x - d_x), ady = I2(a_y - d_y);
+		I2 bdx = I2(b_x - d_x), bdy = I2(b_y - d_y);
+		I2 cdx = I2(c_x - d_x), cdy = I2(c_y - d_y);
+		I4 t1 = (I4(adx) * I4(adx) + I4(ady) * I4(ady)) * I4(I2(bdx * cdy) - I2(bdy * cdx));
+		I4 t2 = (I4(bdx) * I4(bdx) + I4(bdy) * I4(bdy)) * I4(I2(cdx * ady) - I2(cdy * adx));
+		I4 t3 = (I4(cdx) * I4(cdx) + I4(cdy) * I4(cdy)) * I4(I2(adx * bdy) - I2(ady * bdx));
+		return (strict)? (t1 + t2 > -t3) : (t1 + t2 >= -t3);
+	}
+
+	// Exact accumulator for areas and moments of area.
+	typedef Accumulator_Int AccumulatorType;
+
+	// Adds the contribution of the edge (a, b) to the area and the first moments of area.
+	// The area is scaled by 2 and the moments by 6.
+	static void AccumulateEdge(I1 a_x, I1 a_y, I1 b_x, I1 b_y, Accumulator_Int &area, Accumulator_Int &moment_x, Accumulator_Int &moment_y) {
+		Accumulator_Int::AccumulateEdge(a_x, a_y, b_x, b_y, area, moment_x, moment_y);
+	}
+
+	// Adds the contribution of the edge (a, b) to the area only (scaled by 2).
+	static void AccumulateArea(I1 a_x, I1 a_y, I1 b_x, I1 b_y, Accumulator_Int &area) {
+		Accumulator_Int::AccumulateArea(a_x, a_y, b_x, b_y, area);
+	}
+
 	// Returns whether two edges intersect and calculates the intersection point if they do.
 	static bool IntersectionTest(I1 a1_x, I1 a1_y, I1 a2_x, I1 a2_y, I1 b1_x, I1 b1_y, I1 b2_x, I1 b2_y, I2 &res_x, I2 &res_y) {
 		if(a2_x < b2_x) {
@@ -89,6 +213,37 @@ struct NumericalEngine_Int32 {
 		return (strict)? (lhs > rhs) : (lhs >= rhs);
 	}
 
+	// Returns whether d lies inside the circle through a, b and c, which must be ordered such that OrientationTest(a, b, c)
+	// returns true. If strict is false, points on the circle are also accepted. This requires a determinant of degree 4,
+	// which is evaluated as (t1 + t2 >= -t3) so that the intermediate results don't overflow.
+	static bool InCircleTest(int32_t a_x, int32_t a_y, int32_t b_x, int32_t b_y, int32_t c_x, int32_t c_y, int32_t d_x, int32_t d_y, bool strict) {
+		int64_t adx = int64_t(a_x - d_x), ady = int64_t(a_y - d_y);
+		int64_t bdx = int64_t(b_x - d_x), bdy = int64_t(b_y - d_y);
+		int64_t cdx = int64_t(c_x - d_x), cdy = int64_t(c_y - d_y);
+		uint64_t t10, t20, t30, s0, n0;
+		int64_t t11, t21, t31, s1, n1;
+		WideMath::Multiply_64x64_128(uint64_t(adx * adx) + uint64_t(ady * ady), bdx * cdy - bdy * cdx, t10, t11);
+		WideMath::Multiply_64x64_128(uint64_t(bdx * bdx) + uint64_t(bdy * bdy), cdx * ady - cdy * adx, t20, t21);
+		WideMath::Multiply_64x64_128(uint64_t(cdx * cdx) + uint64_t(cdy * cdy), adx * bdy - ady * bdx, t30, t31);
+		WideMath::Add_128(t10, t11, t20, t21, s0, s1);
+		WideMath::Subtract_128(0, 0, t30, t31, n0, n1);
+		return (strict)? WideMath::CompareGreater_128(s0, s1, n0, n1) : WideMath::CompareGreaterEqual_128(s0, s1, n0, n1);
+	}
+
+	// Exact accumulator for areas and moments of area.
+	typedef Accumulator_Int AccumulatorType;
+
+	// Adds the contribution of the edge (a, b) to the area and the first moments of area.
+	// The area is scaled by 2 and the moments by 6.
+	static void AccumulateEdge(int32_t a_x, int32_t a_y, int32_t b_x, int32_t b_y, Accumulator_Int &area, Accumulator_Int &moment_x, Accumulator_Int &moment_y) {
+		Accumulator_Int::AccumulateEdge(a_x, a_y, b_x, b_y, area, moment_x, moment_y);
+	}
+
+	// Adds the contribution of the edge (a, b) to the area only (scaled by 2).
+	static void AccumulateArea(int32_t a_x, int32_t a_y, int32_t b_x, int32_t b_y, Accumulator_Int &area) {
+		Accumulator_Int::AccumulateArea(a_x, a_y, b_x, b_y, area);
+	}
+
 	// Returns whether two edges intersect and calculates the intersection point if they do.
 	static bool IntersectionTest(int32_t a1_x, int32_t a1_y, int32_t a2_x, int32_t a2_y, int32_t b1_x, int32_t b1_y, int32_t b2_x, int32_t b2_y, int64_t &res_x, int64_t &res_y) {
 		if(a2_x < b2_x) {
@@ -175,6 +330,53 @@ struct NumericalEngine_Int64 {
 		return (strict)? WideMath::CompareGreater_128(lhs0, lhs1, rhs0, rhs1) : WideMath::CompareGreaterEqual_128(lhs0, lhs1, rhs0, rhs1);
 	}
 
+	// Returns whether d lies inside the circle through a, b and c, which must be ordered such that OrientationTest(a, b, c)
+	// returns true. If strict is false, points on the circle are also accepted. This requires a determinant of degree 4,
+	// which is evaluated as (t1 + t2 >= -t3) so that the intermediate results don't overflow.
+	static bool InCircleTest(int64_t a_x, int64_t a_y, int64_t b_x, int64_t b_y, int64_t c_x, int64_t c_y, int64_t d_x, int64_t d_y, bool strict) {
+		int64_t adx = a_x - d_x, ady = a_y - d_y;
+		int64_t bdx = b_x - d_x, bdy = b_y - d_y;
+		int64_t cdx = c_x - d_x, cdy = c_y - d_y;
+		uint64_t t10, t11, t12, t20, t21, t22, t30, t31, t32, s0, s1, s2, n0, n1, n2;
+		int64_t t13, t23, t33, s3, n3;
+		InCircleTerm(adx, ady, bdx, bdy, cdx, cdy, t10, t11, t12, t13);
+		InCircleTerm(bdx, bdy, cdx, cdy, adx, ady, t20, t21, t22, t23);
+		InCircleTerm(cdx, cdy, adx, ady, bdx, bdy, t30, t31, t32, t33);
+		WideMath::Add_256(t10, t11, t12, t13, t20, t21, t22, t23, s0, s1, s2, s3);
+		WideMath::Subtract_256(0, 0, 0, 0, t30, t31, t32, t33, n0, n1, n2, n3);
+		return (strict)? WideMath::CompareGreater_256(s0, s1, s2, s3, n0, n1, n2, n3) : WideMath::CompareGreaterEqual_256(s0, s1, s2, s3, n0, n1, n2, n3);
+	}
+
+	// Calculates (x^2 + y^2) * (u1 * v2 - v1 * u2). The first factor is at most 2^127 (unsigned), the second factor
+	// is less than 2^127 (signed), so the result is less than 2^254.
+	static void InCircleTerm(int64_t x, int64_t y, int64_t u1, int64_t v1, int64_t u2, int64_t v2, uint64_t &r0, uint64_t &r1, uint64_t &r2, int64_t &r3) {
+		uint64_t xx0, yy0, lift0, lift1;
+		int64_t xx1, yy1;
+		WideMath::Multiply_64x64_128(x, x, xx0, xx1);
+		WideMath::Multiply_64x64_128(y, y, yy0, yy1);
+		WideMath::Add_128(xx0, uint64_t(xx1), yy0, uint64_t(yy1), lift0, lift1);
+		uint64_t lhs0, rhs0, cross0;
+		int64_t lhs1, rhs1, cross1;
+		WideMath::Multiply_64x64_128(u1, v2, lhs0, lhs1);
+		WideMath::Multiply_64x64_128(v1, u2, rhs0, rhs1);
+		WideMath::Subtract_128(lhs0, lhs1, rhs0, rhs1, cross0, cross1);
+		WideMath::Multiply_128x128_256(lift0, lift1, cross0, cross1, r0, r1, r2, r3);
+	}
+
+	// Exact accumulator for areas and moments of area.
+	typedef Accumulator_Int AccumulatorType;
+
+	// Adds the contribution of the edge (a, b) to the area and the first moments of area.
+	// The area is scaled by 2 and the moments by 6.
+	static void AccumulateEdge(int64_t a_x, int64_t a_y, int64_t b_x, int64_t b_y, Accumulator_Int &area, Accumulator_Int &moment_x, Accumulator_Int &moment_y) {
+		Accumulator_Int::AccumulateEdge(a_x, a_y, b_x, b_y, area, moment_x, moment_y);
+	}
+
+	// Adds the contribution of the edge (a, b) to the area only (scaled by 2).
+	static void AccumulateArea(int64_t a_x, int64_t a_y, int64_t b_x, int64_t b_y, Accumulator_Int &area) {
+		Accumulator_Int::AccumulateArea(a_x, a_y, b_x, b_y, area);
+	}
+
 	// Returns whether two edges intersect and calculates the intersection point if they do.
 	static bool IntersectionTest(int64_t a1_x, int64_t a1_y, int64_t a2_x, int64_t a2_y, int64_t b1_x, int64_t b1_y, int64_t b2_x, int64_t b2_y, Int128 &res_x, Int128 &res_y) {
 		if(a2_x < b2_x) {
@@ -278,6 +480,32 @@ struct NumericalEngine_Float {
 		return (strict)? (lhs > rhs) : (lhs >= rhs);
 	}
 
+	// Returns whether d lies inside the circle through a, b and c, which must be ordered such that OrientationTest(a, b, c)
+	// returns true. If strict is false, points on the circle are also accepted.
+	static bool InCircleTest(F1 a_x, F1 a_y, F1 b_x, F1 b_y, F1 c_x, F1 c_y, F1 d_x, F1 d_y, bool strict) {
+		F2 adx = F2(a_x) - F2(d_x), ady = F2(a_y) - F2(d_y);
+		F2 bdx = F2(b_x) - F2(d_x), bdy = F2(b_y) - F2(d_y);
+		F2 cdx = F2(c_x) - F2(d_x), cdy = F2(c_y) - F2(d_y);
+		F2 t1 = (adx * adx + ady * ady) * (bdx * cdy - bdy * cdx);
+		F2 t2 = (bdx * bdx + bdy * bdy) * (cdx * ady - cdy * adx);
+		F2 t3 = (cdx * cdx + cdy * cdy) * (adx * bdy - ady * bdx);
+		return (strict)? (t1 + t2 > -t3) : (t1 + t2 >= -t3);
+	}
+
+	// Accumulator for areas and moments of area.
+	typedef Accumulator_Float<F2> AccumulatorType;
+
+	// Adds the contribution of the edge (a, b) to the area and the first moments of area.
+	// The area is scaled by 2 and the moments by 6.
+	static void AccumulateEdge(F1 a_x, F1 a_y, F1 b_x, F1 b_y, AccumulatorType &area, AccumulatorType &moment_x, AccumulatorType &moment_y) {
+		AccumulatorType::AccumulateEdge(F2(a_x), F2(a_y), F2(b_x), F2(b_y), area, moment_x, moment_y);
+	}
+
+	// Adds the contribution of the edge (a, b) to the area only (scaled by 2).
+	static void AccumulateArea(F1 a_x, F1 a_y, F1 b_x, F1 b_y, AccumulatorType &area) {
+		AccumulatorType::AccumulateArea(F2(a_x), F2(a_y), F2(b_x), F2(b_y), area);
+	}
+
 	// Returns whether two edges intersect and calculates the intersection point if they do.
 	static bool IntersectionTest(F1 a1_x, F1 a1_y, F1 a2_x, F1 a2_y, F1 b1_x, F1 b1_y, F1 b2_x, F1 b2_y, F2 &res_x, F2 &res_y) {
 		if(a2_x < b2_x) {
@@ -327,4 +555,55 @@ template<> struct NumericalEngine<float  > : NumericalEngine_Float<float, double
 template<> struct NumericalEngine<double > : NumericalEngine_Float<double, __float128> {};
 #endif
 
+// Exact predicates for rectilinear (Manhattan) input, where every edge is horizontal or vertical. Every product in the
+// general predicates then has a factor that is zero, so only the signs of the differences are needed and no wide
+// multiplications or divisions are required. The results are identical to those of NumericalEngine<T>, except that
+// intersections are also exact for floating point types.
+template<typename T>
+struct NumericalEngine_Rectilinear {
+
+	typedef typename NumericalEngine<T>::DoubleType DoubleType;
+
+	// Returns the sign of a - b.
+	static int Sign(T a, T b) {
+		return int(a > b) - int(a < b);
+	}
+
+	// Same as NumericalEngine<T>::OrientationTest, but (a, b) or (a, c) must be horizontal or vertical.
+	static bool OrientationTest(T a_x, T a_y, T b_x, T b_y, T c_x, T c_y, bool strict) {
+		int s = Sign(b_x, a_x) * Sign(c_y, a_y) - Sign(b_y, a_y) * Sign(c_x, a_x);
+		return (strict)? (s > 0) : (s >= 0);
+	}
+
+	// Same as NumericalEngine<T>::IntersectionTest, but both edges must be horizontal or vertical. The edges can only
+	// intersect if one is horizontal and the other is vertical, so the intersection point is always exact.
+	static bool IntersectionTest(T a1_x, T a1_y, T a2_x, T a2_y, T b1_x, T b1_y, T b2_x, T b2_y, DoubleType &res_x, DoubleType &res_y) {
+		if(a2_x < b2_x) {
+			if(Sign(b2_x, b1_x) * Sign(a2_y, b2_y) - Sign(b2_y, b1_y) * Sign(a2_x, b2_x) > 0) {
+				if(Sign(b2_x, b1_x) * Sign(a2_y, a1_y) - Sign(b2_y, b1_y) * Sign(a2_x, a1_x) > 0) {
+					res_x = NumericalEngine<T>::SingleToDouble((a1_x == a2_x)? a1_x : b1_x);
+					res_y = NumericalEngine<T>::SingleToDouble((a1_x == a2_x)? b1_y : a1_y);
+				} else {
+					res_x = NumericalEngine<T>::SingleToDouble(a2_x);
+					res_y = NumericalEngine<T>::SingleToDouble(a2_y);
+				}
+				return true;
+			}
+		} else {
+			if(Sign(a2_y, a1_y) * Sign(b2_x, a2_x) - Sign(a2_x, a1_x) * Sign(b2_y, a2_y) > 0) {
+				if(Sign(a2_y, a1_y) * Sign(b2_x, b1_x) - Sign(a2_x, a1_x) * Sign(b2_y, b1_y) > 0) {
+					res_x = NumericalEngine<T>::SingleToDouble((a1_x == a2_x)? a1_x : b1_x);
+					res_y = NumericalEngine<T>::SingleToDouble((a1_x == a2_x)? b1_y : a1_y);
+				} else {
+					res_x = NumericalEngine<T>::SingleToDouble(b2_x);
+					res_y = NumericalEngine<T>::SingleToDouble(b2_y);
+				}
+				return true;
+			}
+		}
+		return false;
+	}
+
+};
+
 }
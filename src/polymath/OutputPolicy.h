@@ -2,49 +2,61 @@
 
 #include "Common.h"
 
+#include "HalfEdgeMesh.h"
 #include "NumericalEngine.h"
 #include "Polygon.h"
 #include "Vertex.h"
 #include "Visualization.h"
 
+#include <functional>
 #include <memory>
+#include <type_traits>
 
 namespace PolyMath {
 
+// Returns whether vertex b can be removed from the output chain a -> b -> c without changing the shape, i.e. if it is
+// collinear with a and c and lies between them, or coincides with one of them.
 template<typename T>
-class OutputPolicy_Simple {
+inline bool OutputVertexIsRedundant(Vertex<T> a, Vertex<T> b, Vertex<T> c) {
+	if((a.x < b.x && c.x < b.x) || (a.x > b.x && c.x > b.x) || (a.y < b.y && c.y < b.y) || (a.y > b.y && c.y > b.y))
+		return false;
+	return NumericalEngine<T>::OrientationTest(a.x, a.y, b.x, b.y, c.x, c.y, false) && !NumericalEngine<T>::OrientationTest(a.x, a.y, b.x, b.y, c.x, c.y, true);
+}
+
+// The output chains of OutputPolicy_Simple, OutputPolicy_Hierarchy and OutputPolicy_HalfEdge. Every output edge points
+// to the last output vertex of its chain and the vertex before it (the output edge type must have the members
+// m_output_vertex and m_prev_output_vertex). A start vertex begins two chains and a stop vertex joins them. If
+// remove_collinear is true, redundant vertices (see OutputVertexIsRedundant) are removed while the chains are built,
+// and the few that remain are removed by SimplifyLoop when the result is extracted.
+template<typename T>
+class OutputChains {
 
 public:
-	typedef T ValueType;
 	typedef Vertex<T> VertexType;
 
-private:
 	struct OutputVertex {
 		VertexType m_vertex;
 		OutputVertex *m_next;
 	};
 
-public:
-	struct OutputEdge {
-		OutputVertex *m_output_vertex;
-	};
-
-public:
-	static constexpr bool START_NEEDS_PREV_NEXT = false;
-	static constexpr bool STOP_NEEDS_PREV_NEXT = false;
-
 private:
 	static constexpr size_t OUTPUT_VERTEX_BATCH_SIZE = 256;
 
 private:
-	std::vector<std::unique_ptr<OutputVertex[]>> m_output_vertex_batches;
+	std::vector<std::unique_ptr<OutputVertex[]>> m_output_vertex_batches, m_output_vertex_spare_batches;
 	size_t m_output_vertex_batch_used;
+	bool m_remove_collinear;
 
 private:
 	OutputVertex* AddOutputVertex(VertexType vertex) {
 		if(m_output_vertex_batch_used == OUTPUT_VERTEX_BATCH_SIZE) {
-			std::unique_ptr<OutputVertex[]> mem(new OutputVertex[OUTPUT_VERTEX_BATCH_SIZE]);
-			m_output_vertex_batches.push_back(std::move(mem));
+			if(m_output_vertex_spare_batches.empty()) {
+				std::unique_ptr<OutputVertex[]> mem(new OutputVertex[OUTPUT_VERTEX_BATCH_SIZE]);
+				m_output_vertex_batches.push_back(std::move(mem));
+			} else {
+				m_output_vertex_batches.push_back(std::move(m_output_vertex_spare_batches.back()));
+				m_output_vertex_spare_batches.pop_back();
+			}
 			m_output_vertex_batch_used = 0;
 		}
 		OutputVertex *batch = m_output_vertex_batches.back().get();
@@ -55,10 +67,196 @@ private:
 	}
 
 public:
-	OutputPolicy_Simple() {
+	explicit OutputChains(bool remove_collinear) {
+		m_output_vertex_batch_used = OUTPUT_VERTEX_BATCH_SIZE;
+		m_remove_collinear = remove_collinear;
+	}
+
+	// Discards all output vertices but keeps the allocated memory so it can be reused.
+	void Reset() {
+		for(auto &batch : m_output_vertex_batches) {
+			m_output_vertex_spare_batches.push_back(std::move(batch));
+		}
+		m_output_vertex_batches.clear();
 		m_output_vertex_batch_used = OUTPUT_VERTEX_BATCH_SIZE;
 	}
 
+	// Begins two chains at a start vertex and returns the shared output vertex.
+	template<typename OutputEdge>
+	OutputVertex* StartChains(OutputEdge &edge1, OutputEdge &edge2, VertexType vertex) {
+		OutputVertex *output_vertex = AddOutputVertex(vertex);
+		output_vertex->m_next = nullptr;
+		edge1.m_output_vertex = output_vertex;
+		edge1.m_prev_output_vertex = nullptr;
+		edge2.m_output_vertex = output_vertex;
+		edge2.m_prev_output_vertex = nullptr;
+		return output_vertex;
+	}
+
+	// Adds a vertex to the end of a chain. Left chains are built backwards.
+	template<typename OutputEdge>
+	void AddMiddleVertex(OutputEdge &edge, VertexType vertex, bool is_left) {
+		assert(edge.m_output_vertex != nullptr);
+
+		// Remove redundant vertices. The last vertex can be replaced by the new one if it was also created here
+		// (start vertices are shared by two edges). The chain is not affected by this, regardless of the direction.
+		if(m_remove_collinear) {
+			VertexType last = edge.m_output_vertex->m_vertex;
+			if(last.x == vertex.x && last.y == vertex.y)
+				return;
+			if(edge.m_prev_output_vertex != nullptr && OutputVertexIsRedundant(edge.m_prev_output_vertex->m_vertex, last, vertex)) {
+				edge.m_output_vertex->m_vertex = vertex;
+				return;
+			}
+		}
+
+		// create new output vertex
+		OutputVertex *output_vertex = AddOutputVertex(vertex);
+
+		// update edges
+		if(is_left) {
+			output_vertex->m_next = edge.m_output_vertex;
+		} else {
+			output_vertex->m_next = nullptr;
+			edge.m_output_vertex->m_next = output_vertex;
+		}
+		edge.m_prev_output_vertex = edge.m_output_vertex;
+		edge.m_output_vertex = output_vertex;
+
+	}
+
+	// Joins two chains at a stop vertex. The result runs from the last vertex of the tail through the new vertex to the
+	// last vertex of the head.
+	template<typename OutputEdge>
+	void JoinChains(OutputEdge &tail, OutputEdge &head, VertexType vertex) {
+		assert(tail.m_output_vertex != nullptr);
+		assert(head.m_output_vertex != nullptr);
+
+		// Redundant middle vertices at either end are removed by reusing or skipping them, and the new vertex is skipped
+		// if it is redundant itself. Start vertices are never removed. Duplicate vertices count as redundant, so this
+		// also handles chains that already end at the new vertex. Skipped vertices are unlinked so they don't show up as
+		// separate loops.
+		OutputVertex *before, *after, *output_vertex;
+		if(m_remove_collinear && tail.m_prev_output_vertex != nullptr && OutputVertexIsRedundant(tail.m_prev_output_vertex->m_vertex, tail.m_output_vertex->m_vertex, vertex)) {
+			before = tail.m_prev_output_vertex;
+			output_vertex = tail.m_output_vertex;
+			output_vertex->m_vertex = vertex;
+		} else {
+			before = tail.m_output_vertex;
+			output_vertex = AddOutputVertex(vertex);
+			before->m_next = output_vertex;
+		}
+		if(m_remove_collinear && head.m_prev_output_vertex != nullptr && OutputVertexIsRedundant(vertex, head.m_output_vertex->m_vertex, head.m_prev_output_vertex->m_vertex)) {
+			after = head.m_prev_output_vertex;
+			head.m_output_vertex->m_next = nullptr;
+		} else {
+			after = head.m_output_vertex;
+		}
+		if(m_remove_collinear && OutputVertexIsRedundant(before->m_vertex, vertex, after->m_vertex)) {
+			before->m_next = after;
+			output_vertex->m_next = nullptr;
+		} else {
+			output_vertex->m_next = after;
+		}
+
+	}
+
+	// Removes the redundant vertices of a closed loop that could not be removed while the chains were built, such as
+	// start vertices that turned out to be in the middle of a straight edge. Returns a vertex that is still part of the
+	// loop. Removing a vertex can make its predecessor redundant, so this continues until a full cycle has been done
+	// without removing anything.
+	OutputVertex* SimplifyLoop(OutputVertex *first) {
+		if(!m_remove_collinear)
+			return first;
+		size_t n = 0;
+		OutputVertex *w = first;
+		do {
+			++n;
+			w = w->m_next;
+		} while(w != first);
+		OutputVertex *prev = first, *current = first->m_next;
+		for(size_t stable = 0; n > 3 && stable < n; ) {
+			OutputVertex *next = current->m_next;
+			if(OutputVertexIsRedundant(prev->m_vertex, current->m_vertex, next->m_vertex)) {
+				prev->m_next = next;
+				current->m_next = nullptr;
+				if(current == first)
+					first = next;
+				--n;
+				stable = 0;
+			} else {
+				prev = current;
+				++stable;
+			}
+			current = next;
+		}
+		return first;
+	}
+
+	// Returns an upper bound for the number of vertices in the output.
+	size_t GetOutputVertexCount() const {
+		return m_output_vertex_batches.size() * OUTPUT_VERTEX_BATCH_SIZE + m_output_vertex_batch_used - OUTPUT_VERTEX_BATCH_SIZE;
+	}
+
+	// Calls the callback for every output vertex, in the order in which they were created.
+	template<typename Callback>
+	void ForEachOutputVertex(Callback &&callback) {
+		for(size_t i = 0; i < m_output_vertex_batches.size(); ++i) {
+			OutputVertex *batch = m_output_vertex_batches[i].get();
+			size_t batch_size = (i == m_output_vertex_batches.size() - 1)? m_output_vertex_batch_used : OUTPUT_VERTEX_BATCH_SIZE;
+			for(size_t j = 0; j < batch_size; ++j) {
+				callback(&batch[j]);
+			}
+		}
+	}
+
+	void Visualize(Visualization<T> &vis) {
+		ForEachOutputVertex([&](OutputVertex *v) {
+			if(v->m_next != nullptr) {
+				vis.m_output_edges.emplace_back();
+				auto &edge = vis.m_output_edges.back();
+				edge.m_edge_vertices[0] = v->m_vertex;
+				edge.m_edge_vertices[1] = v->m_next->m_vertex;
+			}
+		});
+	}
+
+};
+
+template<typename T>
+class OutputPolicy_Simple {
+
+public:
+	typedef T ValueType;
+	typedef Vertex<T> VertexType;
+
+private:
+	typedef typename OutputChains<T>::OutputVertex OutputVertex;
+
+public:
+	struct OutputEdge {
+		OutputVertex *m_output_vertex, *m_prev_output_vertex;
+	};
+
+public:
+	static constexpr bool START_NEEDS_PREV_NEXT = false;
+	static constexpr bool START_ALWAYS_NEEDS_PREV_NEXT = false;
+	static constexpr bool STOP_NEEDS_PREV_NEXT = false;
+
+private:
+	OutputChains<T> m_chains;
+
+public:
+	// If remove_collinear is true, collinear and duplicate vertices are removed from the output.
+	explicit OutputPolicy_Simple(bool remove_collinear = false)
+		: m_chains(remove_collinear) {
+	}
+
+	// Discards all output but keeps the allocated memory so it can be reused.
+	void Reset() {
+		m_chains.Reset();
+	}
+
 	static bool HasOutputEdge(OutputEdge &edge) {
 		return (edge.m_output_vertex != nullptr);
 	}
@@ -69,192 +267,170 @@ public:
 
 	static void CopyOutputEdge(OutputEdge &from, OutputEdge &to) {
 		to.m_output_vertex = from.m_output_vertex;
+		to.m_prev_output_vertex = from.m_prev_output_vertex;
 	}
 
 	static void SwapOutputEdges(OutputEdge &edge1, OutputEdge &edge2) {
 		std::swap(edge1.m_output_vertex, edge2.m_output_vertex);
+		std::swap(edge1.m_prev_output_vertex, edge2.m_prev_output_vertex);
 	}
 
 	void OutputStartVertex(OutputEdge &edge1, OutputEdge &edge2, VertexType vertex, bool is_split, OutputEdge *edge_prev, OutputEdge *edge_next) {
+		POLYMATH_UNUSED(is_split);
 		POLYMATH_UNUSED(edge_prev);
 		POLYMATH_UNUSED(edge_next);
 
-		// create new output vertex
-		OutputVertex *output_vertex = AddOutputVertex(vertex);
-		output_vertex->m_next = nullptr;
-
-		// update edges
-		edge1.m_output_vertex = output_vertex;
-		edge2.m_output_vertex = output_vertex;
+		// start new chains
+		m_chains.StartChains(edge1, edge2, vertex);
 
 	}
 
 	void OutputMiddleVertex(OutputEdge &edge, VertexType vertex, bool is_left) {
-		assert(edge.m_output_vertex != nullptr);
-
-		// create new output vertex
-		OutputVertex *output_vertex = AddOutputVertex(vertex);
-
-		// update edges
-		if(is_left) {
-			output_vertex->m_next = edge.m_output_vertex;
-			edge.m_output_vertex = output_vertex;
-		} else {
-			output_vertex->m_next = nullptr;
-			edge.m_output_vertex->m_next = output_vertex;
-			edge.m_output_vertex = output_vertex;
-		}
-
+		m_chains.AddMiddleVertex(edge, vertex, is_left);
 	}
 
 	void OutputStopVertex(OutputEdge &edge1, OutputEdge &edge2, VertexType vertex, bool is_merge, OutputEdge *edge_prev, OutputEdge *edge_next) {
 		POLYMATH_UNUSED(edge_prev);
 		POLYMATH_UNUSED(edge_next);
-		assert(edge1.m_output_vertex != nullptr);
-		assert(edge2.m_output_vertex != nullptr);
-
-		// create new output vertex
-		OutputVertex *output_vertex = AddOutputVertex(vertex);
 
-		// update edges
+		// join the chains, the chain of edge1 continues in edge2 for merge vertices, and the other way around otherwise
 		if(is_merge) {
-			edge1.m_output_vertex->m_next = output_vertex;
-			output_vertex->m_next = edge2.m_output_vertex;
+			m_chains.JoinChains(edge1, edge2, vertex);
 		} else {
-			edge2.m_output_vertex->m_next = output_vertex;
-			output_vertex->m_next = edge1.m_output_vertex;
+			m_chains.JoinChains(edge2, edge1, vertex);
 		}
 
 	}
 
 	void Visualize(Visualization<T> &vis) {
-
-		// output edges
-		for(size_t i = 0; i < m_output_vertex_batches.size(); ++i) {
-			OutputVertex *batch = m_output_vertex_batches[i].get();
-			size_t batch_size = (i == m_output_vertex_batches.size() - 1)? m_output_vertex_batch_used : OUTPUT_VERTEX_BATCH_SIZE;
-			for(size_t j = 0; j < batch_size; ++j) {
-				OutputVertex *v = &batch[j];
-				if(v->m_next != nullptr) {
-					vis.m_output_edges.emplace_back();
-					auto &edge = vis.m_output_edges.back();
-					edge.m_edge_vertices[0] = v->m_vertex;
-					edge.m_edge_vertices[1] = v->m_next->m_vertex;
-				}
-			}
-		}
-
+		m_chains.Visualize(vis);
 	}
 
 	template<typename W>
 	Polygon<T, W> Result() {
 		Polygon<T, W> result;
+		ResultInto(result);
+		return result;
+	}
+
+	// Same as Result(), but replaces the contents of an existing polygon so its memory can be reused.
+	template<typename W>
+	void ResultInto(Polygon<T, W> &result) {
+		result.Clear();
 
 		// reserve space for all output vertices
-		result.vertices.reserve(m_output_vertex_batches.size() * OUTPUT_VERTEX_BATCH_SIZE + m_output_vertex_batch_used - OUTPUT_VERTEX_BATCH_SIZE);
+		result.vertices.reserve(m_chains.GetOutputVertexCount());
 
 		// fill polygon with output vertex data
-		for(size_t i = 0; i < m_output_vertex_batches.size(); ++i) {
-			OutputVertex *batch = m_output_vertex_batches[i].get();
-			size_t batch_size = (i == m_output_vertex_batches.size() - 1)? m_output_vertex_batch_used : OUTPUT_VERTEX_BATCH_SIZE;
-			for(size_t j = 0; j < batch_size; ++j) {
-				OutputVertex *v = &batch[j];
-				if(v->m_next != nullptr) {
-					OutputVertex *w = v;
-					while(w->m_next != nullptr) {
-						result.AddVertex(w->m_vertex);
-						OutputVertex *next = w->m_next;
-						w->m_next = nullptr;
-						w = next;
-					}
-					result.AddLoopEnd(1);
+		m_chains.ForEachOutputVertex([&](OutputVertex *v) {
+			if(v->m_next != nullptr) {
+				OutputVertex *w = m_chains.SimplifyLoop(v);
+				while(w->m_next != nullptr) {
+					result.AddVertex(w->m_vertex);
+					OutputVertex *next = w->m_next;
+					w->m_next = nullptr;
+					w = next;
 				}
+				result.AddLoopEnd(1);
 			}
-		}
+		});
 
-		return result;
 	}
 
 };
 
 template<typename T>
-class OutputPolicy_Keyhole {
+class OutputPolicy_Hierarchy {
 
 public:
 	typedef T ValueType;
 	typedef Vertex<T> VertexType;
 
-private:
-	struct OutputVertex {
-		VertexType m_vertex;
-		OutputVertex *m_next;
-	};
+protected:
+	typedef typename OutputChains<T>::OutputVertex OutputVertex;
 	struct StartVertex {
 		StartVertex *m_parent;
-		size_t m_reference_count;
+		StartVertex *m_first; // first start vertex of the loop (only valid for roots)
+		StartVertex *m_enclosing;
 		OutputVertex *m_output_vertex;
+		size_t m_index, m_size, m_loop;
+		bool m_is_hole;
 	};
 
 public:
 	struct OutputEdge {
-		OutputVertex *m_output_vertex;
-		StartVertex *m_start_vertex, *m_cut_vertex;
+		OutputVertex *m_output_vertex, *m_prev_output_vertex;
+		StartVertex *m_start_vertex;
 	};
 
 public:
-	static constexpr bool START_NEEDS_PREV_NEXT = true;
-	static constexpr bool STOP_NEEDS_PREV_NEXT = true;
+	static constexpr bool START_NEEDS_PREV_NEXT = false;
+	static constexpr bool START_ALWAYS_NEEDS_PREV_NEXT = true;
+	static constexpr bool STOP_NEEDS_PREV_NEXT = false;
 
-private:
-	static constexpr size_t OUTPUT_VERTEX_BATCH_SIZE = 256;
+protected:
 	static constexpr size_t START_VERTEX_BATCH_SIZE = 256;
 
-private:
-	std::vector<std::unique_ptr<OutputVertex[]>> m_output_vertex_batches;
-	std::vector<std::unique_ptr<StartVertex[]>> m_start_vertex_batches;
-	size_t m_output_vertex_batch_used, m_start_vertex_batch_used;
+protected:
+	OutputChains<T> m_chains;
+	std::vector<std::unique_ptr<StartVertex[]>> m_start_vertex_batches, m_start_vertex_spare_batches;
+	size_t m_start_vertex_batch_used;
+	size_t m_start_vertex_count;
 
-private:
-	OutputVertex* AddOutputVertex(VertexType vertex) {
-		if(m_output_vertex_batch_used == OUTPUT_VERTEX_BATCH_SIZE) {
-			std::unique_ptr<OutputVertex[]> mem(new OutputVertex[OUTPUT_VERTEX_BATCH_SIZE]);
-			m_output_vertex_batches.push_back(std::move(mem));
-			m_output_vertex_batch_used = 0;
-		}
-		OutputVertex *batch = m_output_vertex_batches.back().get();
-		OutputVertex *v = &batch[m_output_vertex_batch_used];
-		v->m_vertex = vertex;
-		++m_output_vertex_batch_used;
-		return v;
-	}
+	// temporary storage for the result
+	std::vector<size_t> m_loop_parents;
 
+protected:
 	StartVertex* AddStartVertex() {
 		if(m_start_vertex_batch_used == START_VERTEX_BATCH_SIZE) {
-			std::unique_ptr<StartVertex[]> mem(new StartVertex[START_VERTEX_BATCH_SIZE]);
-			m_start_vertex_batches.push_back(std::move(mem));
+			if(m_start_vertex_spare_batches.empty()) {
+				std::unique_ptr<StartVertex[]> mem(new StartVertex[START_VERTEX_BATCH_SIZE]);
+				m_start_vertex_batches.push_back(std::move(mem));
+			} else {
+				m_start_vertex_batches.push_back(std::move(m_start_vertex_spare_batches.back()));
+				m_start_vertex_spare_batches.pop_back();
+			}
 			m_start_vertex_batch_used = 0;
 		}
 		StartVertex *batch = m_start_vertex_batches.back().get();
 		StartVertex *v = &batch[m_start_vertex_batch_used];
 		v->m_parent = nullptr;
-		v->m_reference_count = 1;
+		v->m_first = v;
+		v->m_index = m_start_vertex_count++;
+		v->m_size = 1;
 		++m_start_vertex_batch_used;
 		return v;
 	}
 
+	// iterative with path halving, since the trees can get deep for loops with many start vertices
 	StartVertex *FindStartVertexRoot(StartVertex *vertex) {
 		assert(vertex != nullptr);
-		if(vertex->m_parent == nullptr)
-			return vertex;
-		StartVertex *root = FindStartVertexRoot(vertex->m_parent);
-		vertex->m_parent = root;
-		return root;
+		while(vertex->m_parent != nullptr) {
+			if(vertex->m_parent->m_parent != nullptr)
+				vertex->m_parent = vertex->m_parent->m_parent;
+			vertex = vertex->m_parent;
+		}
+		return vertex;
 	}
 
 public:
-	OutputPolicy_Keyhole() {
-		m_output_vertex_batch_used = OUTPUT_VERTEX_BATCH_SIZE;
+	// If remove_collinear is true, collinear and duplicate vertices are removed from the output.
+	explicit OutputPolicy_Hierarchy(bool remove_collinear = false)
+		: m_chains(remove_collinear) {
 		m_start_vertex_batch_used = START_VERTEX_BATCH_SIZE;
+		m_start_vertex_count = 0;
+	}
+
+	// Discards all output but keeps the allocated memory so it can be reused.
+	void Reset() {
+		m_chains.Reset();
+		for(auto &batch : m_start_vertex_batches) {
+			m_start_vertex_spare_batches.push_back(std::move(batch));
+		}
+		m_start_vertex_batches.clear();
+		m_start_vertex_batch_used = START_VERTEX_BATCH_SIZE;
+		m_start_vertex_count = 0;
+		m_loop_parents.clear();
 	}
 
 	static bool HasOutputEdge(OutputEdge &edge) {
@@ -267,66 +443,441 @@ public:
 
 	static void CopyOutputEdge(OutputEdge &from, OutputEdge &to) {
 		to.m_output_vertex = from.m_output_vertex;
-		to.m_cut_vertex = from.m_cut_vertex;
+		to.m_prev_output_vertex = from.m_prev_output_vertex;
 		to.m_start_vertex = from.m_start_vertex;
 	}
 
 	static void SwapOutputEdges(OutputEdge &edge1, OutputEdge &edge2) {
 		std::swap(edge1.m_output_vertex, edge2.m_output_vertex);
-		std::swap(edge1.m_cut_vertex, edge2.m_cut_vertex);
+		std::swap(edge1.m_prev_output_vertex, edge2.m_prev_output_vertex);
 		std::swap(edge1.m_start_vertex, edge2.m_start_vertex);
 	}
 
 	void OutputStartVertex(OutputEdge &edge1, OutputEdge &edge2, VertexType vertex, bool is_split, OutputEdge *edge_prev, OutputEdge *edge_next) {
+		POLYMATH_UNUSED(edge_next);
 
-		if(is_split && edge_prev->m_cut_vertex != nullptr && edge_prev->m_cut_vertex->m_parent == nullptr) {
-			assert(edge_prev != nullptr);
-			assert(edge_next != nullptr);
-			assert(edge_prev->m_cut_vertex->m_reference_count == 0);
-
-			// reuse existing start vertex
-			StartVertex *start_vertex = edge_prev->m_cut_vertex;
-			start_vertex->m_reference_count = 1;
-			edge_prev->m_cut_vertex = nullptr;
-			edge_next->m_cut_vertex = nullptr;
-
-			// create two output vertices
-			OutputVertex *output_vertex1 = AddOutputVertex(vertex);
-			OutputVertex *output_vertex2 = AddOutputVertex(vertex);
-			output_vertex1->m_next = nullptr;
-			output_vertex2->m_next = start_vertex->m_output_vertex->m_next;
-			start_vertex->m_output_vertex->m_next = output_vertex1;
+		// start new chains
+		OutputVertex *output_vertex = m_chains.StartChains(edge1, edge2, vertex);
 
-			// update edges
-			edge1.m_output_vertex = output_vertex1;
-			edge1.m_cut_vertex = nullptr;
-			edge1.m_start_vertex = start_vertex;
-			edge2.m_output_vertex = output_vertex2;
-			edge2.m_cut_vertex = nullptr;
-			edge2.m_start_vertex = start_vertex;
+		// Create new start vertex. If this turns out to be the first vertex of the loop, the previous output edge
+		// is the closest edge of a different loop below it, which is used later to find the enclosing loop.
+		StartVertex *start_vertex = AddStartVertex();
+		start_vertex->m_enclosing = (edge_prev == nullptr)? nullptr : edge_prev->m_start_vertex;
+		start_vertex->m_output_vertex = output_vertex;
+		start_vertex->m_is_hole = is_split;
 
-		} else {
+		// update edges
+		edge1.m_start_vertex = start_vertex;
+		edge2.m_start_vertex = start_vertex;
 
-			// create new start vertex
-			StartVertex *start_vertex = AddStartVertex();
+	}
 
-			// create new output vertex
-			OutputVertex *output_vertex = AddOutputVertex(vertex);
-			output_vertex->m_next = nullptr;
+	void OutputMiddleVertex(OutputEdge &edge, VertexType vertex, bool is_left) {
+		m_chains.AddMiddleVertex(edge, vertex, is_left);
+	}
 
-			// update edges
-			edge1.m_output_vertex = output_vertex;
-			edge1.m_cut_vertex = nullptr;
-			edge1.m_start_vertex = start_vertex;
-			edge2.m_output_vertex = output_vertex;
-			edge2.m_cut_vertex = nullptr;
-			edge2.m_start_vertex = start_vertex;
+	void OutputStopVertex(OutputEdge &edge1, OutputEdge &edge2, VertexType vertex, bool is_merge, OutputEdge *edge_prev, OutputEdge *edge_next) {
+		POLYMATH_UNUSED(edge_prev);
+		POLYMATH_UNUSED(edge_next);
 
+		// join the chains, the chain of edge1 continues in edge2 for merge vertices, and the other way around otherwise
+		if(is_merge) {
+			m_chains.JoinChains(edge1, edge2, vertex);
+		} else {
+			m_chains.JoinChains(edge2, edge1, vertex);
 		}
 
-	}
-
-	void OutputMiddleVertex(OutputEdge &edge, VertexType vertex, bool is_left) {
+		// join the loops (union by size), the root keeps track of the start vertex that came first
+		StartVertex *root1 = FindStartVertexRoot(edge1.m_start_vertex);
+		StartVertex *root2 = FindStartVertexRoot(edge2.m_start_vertex);
+		if(root1 != root2) {
+			if(root1->m_size < root2->m_size)
+				std::swap(root1, root2);
+			root2->m_parent = root1;
+			root1->m_size += root2->m_size;
+			if(root2->m_first->m_index < root1->m_first->m_index)
+				root1->m_first = root2->m_first;
+		}
+
+	}
+
+	void Visualize(Visualization<T> &vis) {
+		m_chains.Visualize(vis);
+	}
+
+	template<typename W>
+	Polygon<T, W> Result() {
+		Polygon<T, W> result;
+		ResultInto(result, m_loop_parents);
+		return result;
+	}
+
+	template<typename W>
+	void ResultInto(Polygon<T, W> &result) {
+		ResultInto(result, m_loop_parents);
+	}
+
+	template<typename W>
+	Polygon<T, W> Result(std::vector<size_t> &loop_parents) {
+		Polygon<T, W> result;
+		ResultInto(result, loop_parents);
+		return result;
+	}
+
+	// Returns the output loops, sorted such that every loop comes after the loop that encloses it. The index of the
+	// enclosing loop is stored in loop_parents (INDEX_NONE for top-level loops). Loops with an even depth are outer
+	// loops, the others are holes.
+	template<typename W>
+	void ResultInto(Polygon<T, W> &result, std::vector<size_t> &loop_parents) {
+		result.Clear();
+
+		// reserve space for all output vertices
+		result.vertices.reserve(m_chains.GetOutputVertexCount());
+
+		// add vertices
+		ForEachLoop(loop_parents, [&](OutputVertex *first, bool is_hole) {
+			POLYMATH_UNUSED(is_hole);
+			OutputVertex *w = first;
+			do {
+				result.AddVertex(w->m_vertex);
+				w = w->m_next;
+			} while(w != first);
+			result.AddLoopEnd(1);
+		});
+
+	}
+
+protected:
+	// Calls the callback for every output loop with its first output vertex and whether it is a hole. The loops are
+	// handled in the order of their first vertex, and the index of the enclosing loop is added to loop_parents before
+	// the callback is called.
+	template<typename Callback>
+	void ForEachLoop(std::vector<size_t> &loop_parents, Callback &&callback) {
+		loop_parents.clear();
+
+		// Every loop is handled at its first start vertex, and the loop that encloses it always started earlier.
+		for(size_t i = 0; i < m_start_vertex_batches.size(); ++i) {
+			StartVertex *batch = m_start_vertex_batches[i].get();
+			size_t batch_size = (i == m_start_vertex_batches.size() - 1)? m_start_vertex_batch_used : START_VERTEX_BATCH_SIZE;
+			for(size_t j = 0; j < batch_size; ++j) {
+				StartVertex *v = &batch[j];
+				if(FindStartVertexRoot(v)->m_first != v)
+					continue;
+
+				// find the parent: the closest loop below the first vertex is either the parent or a sibling
+				size_t parent = INDEX_NONE;
+				if(v->m_enclosing != nullptr) {
+					StartVertex *below = FindStartVertexRoot(v->m_enclosing)->m_first;
+					parent = (below->m_is_hole != v->m_is_hole)? below->m_loop : loop_parents[below->m_loop];
+				}
+				v->m_loop = loop_parents.size();
+				loop_parents.push_back(parent);
+
+				v->m_output_vertex = m_chains.SimplifyLoop(v->m_output_vertex);
+				callback(v->m_output_vertex, v->m_is_hole);
+
+			}
+		}
+
+	}
+
+};
+
+// Same as OutputPolicy_Hierarchy, but the result is a half-edge mesh.
+template<typename T>
+class OutputPolicy_HalfEdge : public OutputPolicy_Hierarchy<T> {
+
+public:
+	typedef T ValueType;
+	typedef Vertex<T> VertexType;
+
+private:
+	typedef OutputPolicy_Hierarchy<T> Base;
+	typedef typename Base::OutputVertex OutputVertex;
+
+private:
+	// temporary storage for the result
+	std::vector<size_t> m_loop_ends;
+
+public:
+	// If remove_collinear is true, collinear and duplicate vertices are removed from the output.
+	explicit OutputPolicy_HalfEdge(bool remove_collinear = false)
+		: Base(remove_collinear) {
+	}
+
+	HalfEdgeMesh<T> ResultMesh() {
+		HalfEdgeMesh<T> mesh;
+		ResultMeshInto(mesh);
+		return mesh;
+	}
+
+	// Same as ResultMesh(), but replaces the contents of an existing mesh so its memory can be reused.
+	void ResultMeshInto(HalfEdgeMesh<T> &mesh) {
+		mesh.Clear();
+
+		// The vertices of each loop are stored in the order of the output chain, which has the filled region on the
+		// right side. Half-edge 2*i runs from vertex i+1 to vertex i (filled side), its twin is half-edge 2*i+1.
+		size_t n = this->m_chains.GetOutputVertexCount();
+		mesh.vertices.reserve(n);
+		mesh.half_edges.reserve(2 * n);
+
+		// Handle the loops in the order of their first vertex, same as OutputPolicy_Hierarchy. Face 0 is the
+		// unbounded face, face i+1 is the face bounded by the outer side of loop i.
+		std::vector<size_t> &loop_parents = this->m_loop_parents;
+		std::vector<size_t> &loop_ends = m_loop_ends;
+		loop_ends.clear();
+		mesh.faces.resize(1);
+		mesh.faces[0].outer_half_edge = INDEX_NONE;
+		mesh.faces[0].filled = false;
+		this->ForEachLoop(loop_parents, [&](OutputVertex *first, bool is_hole) {
+			size_t parent = loop_parents.back();
+
+			// add vertices
+			size_t begin = mesh.vertices.size();
+			OutputVertex *w = first;
+			do {
+				mesh.vertices.emplace_back();
+				mesh.vertices.back().position = w->m_vertex;
+				w = w->m_next;
+			} while(w != first);
+			size_t end = mesh.vertices.size();
+			loop_ends.push_back(end);
+
+			// The outer side of an outer loop is the filled side, the outer side of a hole is the unfilled side.
+			// The inner side belongs to the face of the parent loop.
+			size_t outer_face = mesh.faces.size(), inner_face = (parent == INDEX_NONE)? 0 : parent + 1;
+			size_t filled_face = (is_hole)? inner_face : outer_face;
+			size_t unfilled_face = (is_hole)? outer_face : inner_face;
+			mesh.faces.emplace_back();
+			mesh.faces.back().outer_half_edge = (is_hole)? 2 * begin + 1 : 2 * begin;
+			mesh.faces.back().filled = !is_hole;
+
+			// add half-edges
+			mesh.half_edges.resize(2 * end);
+			for(size_t k = begin; k < end; ++k) {
+				size_t k_prev = (k == begin)? end - 1 : k - 1;
+				size_t k_next = (k == end - 1)? begin : k + 1;
+				typename HalfEdgeMesh<T>::HalfEdge &edge1 = mesh.half_edges[2 * k];
+				edge1.origin = k_next;
+				edge1.twin = 2 * k + 1;
+				edge1.next = 2 * k_prev;
+				edge1.prev = 2 * k_next;
+				edge1.face = filled_face;
+				typename HalfEdgeMesh<T>::HalfEdge &edge2 = mesh.half_edges[2 * k + 1];
+				edge2.origin = k;
+				edge2.twin = 2 * k;
+				edge2.next = 2 * k_next + 1;
+				edge2.prev = 2 * k_prev + 1;
+				edge2.face = unfilled_face;
+				mesh.vertices[k].half_edge = 2 * k + 1;
+			}
+
+		});
+
+		// Group the inner components by face. The inner side of every loop is an inner component of the face of its
+		// parent (or the unbounded face), so this is a counting sort on the parent index.
+		for(size_t i = 0; i < mesh.faces.size(); ++i) {
+			mesh.faces[i].inner_end = 0;
+		}
+		for(size_t i = 0; i < loop_parents.size(); ++i) {
+			size_t face = (loop_parents[i] == INDEX_NONE)? 0 : loop_parents[i] + 1;
+			++mesh.faces[face].inner_end;
+		}
+		size_t total = 0;
+		for(size_t i = 0; i < mesh.faces.size(); ++i) {
+			total += mesh.faces[i].inner_end;
+			mesh.faces[i].inner_end = total;
+		}
+		mesh.inner_half_edges.resize(total);
+		for(size_t i = loop_parents.size(); i-- > 0; ) {
+			size_t face = (loop_parents[i] == INDEX_NONE)? 0 : loop_parents[i] + 1;
+			size_t begin = (i == 0)? 0 : loop_ends[i - 1];
+			size_t edge = (mesh.half_edges[2 * begin].face == face)? 2 * begin : 2 * begin + 1;
+			mesh.inner_half_edges[--mesh.faces[face].inner_end] = edge;
+		}
+		for(size_t i = 0; i < mesh.faces.size(); ++i) {
+			mesh.faces[i].inner_end = (i == mesh.faces.size() - 1)? total : mesh.faces[i + 1].inner_end;
+		}
+
+	}
+
+};
+
+template<typename T>
+class OutputPolicy_Keyhole {
+
+public:
+	typedef T ValueType;
+	typedef Vertex<T> VertexType;
+
+private:
+	struct OutputVertex {
+		VertexType m_vertex;
+		OutputVertex *m_next;
+	};
+	struct StartVertex {
+		StartVertex *m_parent;
+		size_t m_reference_count;
+		OutputVertex *m_output_vertex;
+	};
+
+public:
+	struct OutputEdge {
+		OutputVertex *m_output_vertex;
+		StartVertex *m_start_vertex, *m_cut_vertex;
+	};
+
+public:
+	static constexpr bool START_NEEDS_PREV_NEXT = true;
+	static constexpr bool START_ALWAYS_NEEDS_PREV_NEXT = false;
+	static constexpr bool STOP_NEEDS_PREV_NEXT = true;
+
+private:
+	static constexpr size_t OUTPUT_VERTEX_BATCH_SIZE = 256;
+	static constexpr size_t START_VERTEX_BATCH_SIZE = 256;
+
+private:
+	std::vector<std::unique_ptr<OutputVertex[]>> m_output_vertex_batches, m_output_vertex_spare_batches;
+	std::vector<std::unique_ptr<StartVertex[]>> m_start_vertex_batches, m_start_vertex_spare_batches;
+	size_t m_output_vertex_batch_used, m_start_vertex_batch_used;
+
+private:
+	OutputVertex* AddOutputVertex(VertexType vertex) {
+		if(m_output_vertex_batch_used == OUTPUT_VERTEX_BATCH_SIZE) {
+			if(m_output_vertex_spare_batches.empty()) {
+				std::unique_ptr<OutputVertex[]> mem(new OutputVertex[OUTPUT_VERTEX_BATCH_SIZE]);
+				m_output_vertex_batches.push_back(std::move(mem));
+			} else {
+				m_output_vertex_batches.push_back(std::move(m_output_vertex_spare_batches.back()));
+				m_output_vertex_spare_batches.pop_back();
+			}
+			m_output_vertex_batch_used = 0;
+		}
+		OutputVertex *batch = m_output_vertex_batches.back().get();
+		OutputVertex *v = &batch[m_output_vertex_batch_used];
+		v->m_vertex = vertex;
+		++m_output_vertex_batch_used;
+		return v;
+	}
+
+	StartVertex* AddStartVertex() {
+		if(m_start_vertex_batch_used == START_VERTEX_BATCH_SIZE) {
+			if(m_start_vertex_spare_batches.empty()) {
+				std::unique_ptr<StartVertex[]> mem(new StartVertex[START_VERTEX_BATCH_SIZE]);
+				m_start_vertex_batches.push_back(std::move(mem));
+			} else {
+				m_start_vertex_batches.push_back(std::move(m_start_vertex_spare_batches.back()));
+				m_start_vertex_spare_batches.pop_back();
+			}
+			m_start_vertex_batch_used = 0;
+		}
+		StartVertex *batch = m_start_vertex_batches.back().get();
+		StartVertex *v = &batch[m_start_vertex_batch_used];
+		v->m_parent = nullptr;
+		v->m_reference_count = 1;
+		++m_start_vertex_batch_used;
+		return v;
+	}
+
+	StartVertex *FindStartVertexRoot(StartVertex *vertex) {
+		assert(vertex != nullptr);
+		if(vertex->m_parent == nullptr)
+			return vertex;
+		StartVertex *root = FindStartVertexRoot(vertex->m_parent);
+		vertex->m_parent = root;
+		return root;
+	}
+
+public:
+	OutputPolicy_Keyhole() {
+		m_output_vertex_batch_used = OUTPUT_VERTEX_BATCH_SIZE;
+		m_start_vertex_batch_used = START_VERTEX_BATCH_SIZE;
+	}
+
+	// Discards all output but keeps the allocated memory so it can be reused.
+	void Reset() {
+		for(auto &batch : m_output_vertex_batches) {
+			m_output_vertex_spare_batches.push_back(std::move(batch));
+		}
+		m_output_vertex_batches.clear();
+		for(auto &batch : m_start_vertex_batches) {
+			m_start_vertex_spare_batches.push_back(std::move(batch));
+		}
+		m_start_vertex_batches.clear();
+		m_output_vertex_batch_used = OUTPUT_VERTEX_BATCH_SIZE;
+		m_start_vertex_batch_used = START_VERTEX_BATCH_SIZE;
+	}
+
+	static bool HasOutputEdge(OutputEdge &edge) {
+		return (edge.m_output_vertex != nullptr);
+	}
+
+	static void ClearOutputEdge(OutputEdge &edge) {
+		edge.m_output_vertex = nullptr;
+	}
+
+	static void CopyOutputEdge(OutputEdge &from, OutputEdge &to) {
+		to.m_output_vertex = from.m_output_vertex;
+		to.m_cut_vertex = from.m_cut_vertex;
+		to.m_start_vertex = from.m_start_vertex;
+	}
+
+	static void SwapOutputEdges(OutputEdge &edge1, OutputEdge &edge2) {
+		std::swap(edge1.m_output_vertex, edge2.m_output_vertex);
+		std::swap(edge1.m_cut_vertex, edge2.m_cut_vertex);
+		std::swap(edge1.m_start_vertex, edge2.m_start_vertex);
+	}
+
+	void OutputStartVertex(OutputEdge &edge1, OutputEdge &edge2, VertexType vertex, bool is_split, OutputEdge *edge_prev, OutputEdge *edge_next) {
+
+		if(is_split && edge_prev->m_cut_vertex != nullptr && edge_prev->m_cut_vertex->m_parent == nullptr) {
+			assert(edge_prev != nullptr);
+			assert(edge_next != nullptr);
+			assert(edge_prev->m_cut_vertex->m_reference_count == 0);
+
+			// reuse existing start vertex
+			StartVertex *start_vertex = edge_prev->m_cut_vertex;
+			start_vertex->m_reference_count = 1;
+			edge_prev->m_cut_vertex = nullptr;
+			edge_next->m_cut_vertex = nullptr;
+
+			// create two output vertices
+			OutputVertex *output_vertex1 = AddOutputVertex(vertex);
+			OutputVertex *output_vertex2 = AddOutputVertex(vertex);
+			output_vertex1->m_next = nullptr;
+			output_vertex2->m_next = start_vertex->m_output_vertex->m_next;
+			start_vertex->m_output_vertex->m_next = output_vertex1;
+
+			// update edges
+			edge1.m_output_vertex = output_vertex1;
+			edge1.m_cut_vertex = nullptr;
+			edge1.m_start_vertex = start_vertex;
+			edge2.m_output_vertex = output_vertex2;
+			edge2.m_cut_vertex = nullptr;
+			edge2.m_start_vertex = start_vertex;
+
+		} else {
+
+			// create new start vertex
+			StartVertex *start_vertex = AddStartVertex();
+
+			// create new output vertex
+			OutputVertex *output_vertex = AddOutputVertex(vertex);
+			output_vertex->m_next = nullptr;
+
+			// update edges
+			edge1.m_output_vertex = output_vertex;
+			edge1.m_cut_vertex = nullptr;
+			edge1.m_start_vertex = start_vertex;
+			edge2.m_output_vertex = output_vertex;
+			edge2.m_cut_vertex = nullptr;
+			edge2.m_start_vertex = start_vertex;
+
+		}
+
+	}
+
+	void OutputMiddleVertex(OutputEdge &edge, VertexType vertex, bool is_left) {
 		assert(edge.m_output_vertex != nullptr);
 
 		if(edge.m_cut_vertex != nullptr && edge.m_cut_vertex->m_parent == nullptr) {
@@ -511,6 +1062,14 @@ public:
 	template<typename W>
 	Polygon<T, W> Result() {
 		Polygon<T, W> result;
+		ResultInto(result);
+		return result;
+	}
+
+	// Same as Result(), but replaces the contents of an existing polygon so its memory can be reused.
+	template<typename W>
+	void ResultInto(Polygon<T, W> &result) {
+		result.Clear();
 
 		// reserve space for all output vertices
 		result.vertices.reserve(m_output_vertex_batches.size() * OUTPUT_VERTEX_BATCH_SIZE + m_output_vertex_batch_used - OUTPUT_VERTEX_BATCH_SIZE);
@@ -532,7 +1091,6 @@ public:
 			}
 		}
 
-		return result;
 	}
 
 };
@@ -544,7 +1102,7 @@ public:
 	typedef T ValueType;
 	typedef Vertex<T> VertexType;
 
-private:
+protected:
 	struct OutputVertex {
 		VertexType m_vertex;
 		OutputVertex *m_next;
@@ -564,22 +1122,28 @@ public:
 
 public:
 	static constexpr bool START_NEEDS_PREV_NEXT = true;
+	static constexpr bool START_ALWAYS_NEEDS_PREV_NEXT = false;
 	static constexpr bool STOP_NEEDS_PREV_NEXT = false;
 
-private:
+protected:
 	static constexpr size_t OUTPUT_VERTEX_BATCH_SIZE = 256;
 	static constexpr size_t OUTPUT_POLYGON_BATCH_SIZE = 256;
 
-private:
-	std::vector<std::unique_ptr<OutputVertex[]>> m_output_vertex_batches;
-	std::vector<std::unique_ptr<OutputPolygon[]>> m_output_polygon_batches;
+protected:
+	std::vector<std::unique_ptr<OutputVertex[]>> m_output_vertex_batches, m_output_vertex_spare_batches;
+	std::vector<std::unique_ptr<OutputPolygon[]>> m_output_polygon_batches, m_output_polygon_spare_batches;
 	size_t m_output_vertex_batch_used, m_output_polygon_batch_used;
 
-private:
+protected:
 	OutputVertex* AddOutputVertex(VertexType vertex) {
 		if(m_output_vertex_batch_used == OUTPUT_VERTEX_BATCH_SIZE) {
-			std::unique_ptr<OutputVertex[]> mem(new OutputVertex[OUTPUT_VERTEX_BATCH_SIZE]);
-			m_output_vertex_batches.push_back(std::move(mem));
+			if(m_output_vertex_spare_batches.empty()) {
+				std::unique_ptr<OutputVertex[]> mem(new OutputVertex[OUTPUT_VERTEX_BATCH_SIZE]);
+				m_output_vertex_batches.push_back(std::move(mem));
+			} else {
+				m_output_vertex_batches.push_back(std::move(m_output_vertex_spare_batches.back()));
+				m_output_vertex_spare_batches.pop_back();
+			}
 			m_output_vertex_batch_used = 0;
 		}
 		OutputVertex *batch = m_output_vertex_batches.back().get();
@@ -591,8 +1155,13 @@ private:
 
 	OutputPolygon* AddOutputPolygon() {
 		if(m_output_polygon_batch_used == OUTPUT_POLYGON_BATCH_SIZE) {
-			std::unique_ptr<OutputPolygon[]> mem(new OutputPolygon[OUTPUT_POLYGON_BATCH_SIZE]);
-			m_output_polygon_batches.push_back(std::move(mem));
+			if(m_output_polygon_spare_batches.empty()) {
+				std::unique_ptr<OutputPolygon[]> mem(new OutputPolygon[OUTPUT_POLYGON_BATCH_SIZE]);
+				m_output_polygon_batches.push_back(std::move(mem));
+			} else {
+				m_output_polygon_batches.push_back(std::move(m_output_polygon_spare_batches.back()));
+				m_output_polygon_spare_batches.pop_back();
+			}
 			m_output_polygon_batch_used = 0;
 		}
 		OutputPolygon *batch = m_output_polygon_batches.back().get();
@@ -601,17 +1170,44 @@ private:
 		return v;
 	}
 
+	// Calls the callback for every monotone polygon. Chain 1 runs from the top of the first chain down to the start
+	// vertex, chain 2 does the same for the second chain but also ends with the start vertex, which isn't part of it.
+	template<typename Callback>
+	void ForEachPolygon(Callback &&callback) {
+		for(size_t i = 0; i < m_output_polygon_batches.size(); ++i) {
+			OutputPolygon *batch = m_output_polygon_batches[i].get();
+			size_t batch_size = (i == m_output_polygon_batches.size() - 1)? m_output_polygon_batch_used : OUTPUT_POLYGON_BATCH_SIZE;
+			for(size_t j = 0; j < batch_size; ++j) {
+				callback(&batch[j]);
+			}
+		}
+	}
+
 public:
 	OutputPolicy_Monotone() {
 		m_output_vertex_batch_used = OUTPUT_VERTEX_BATCH_SIZE;
 		m_output_polygon_batch_used = OUTPUT_POLYGON_BATCH_SIZE;
 	}
 
-	static bool HasOutputEdge(OutputEdge &edge) {
-		return (edge.m_output_polygon != nullptr);
-	}
-
-	static void ClearOutputEdge(OutputEdge &edge) {
+	// Discards all output but keeps the allocated memory so it can be reused.
+	void Reset() {
+		for(auto &batch : m_output_vertex_batches) {
+			m_output_vertex_spare_batches.push_back(std::move(batch));
+		}
+		m_output_vertex_batches.clear();
+		for(auto &batch : m_output_polygon_batches) {
+			m_output_polygon_spare_batches.push_back(std::move(batch));
+		}
+		m_output_polygon_batches.clear();
+		m_output_vertex_batch_used = OUTPUT_VERTEX_BATCH_SIZE;
+		m_output_polygon_batch_used = OUTPUT_POLYGON_BATCH_SIZE;
+	}
+
+	static bool HasOutputEdge(OutputEdge &edge) {
+		return (edge.m_output_polygon != nullptr);
+	}
+
+	static void ClearOutputEdge(OutputEdge &edge) {
 		edge.m_output_polygon = nullptr;
 	}
 
@@ -740,6 +1336,7 @@ public:
 	}
 
 	void OutputMiddleVertex(OutputEdge &edge, VertexType vertex, bool is_left) {
+		POLYMATH_UNUSED(is_left);
 		assert(edge.m_output_polygon != nullptr);
 
 		if(edge.m_output_forward) {
@@ -781,6 +1378,7 @@ public:
 	}
 
 	void OutputStopVertex(OutputEdge &edge1, OutputEdge &edge2, VertexType vertex, bool is_merge, OutputEdge *edge_prev, OutputEdge *edge_next) {
+		POLYMATH_UNUSED(is_merge);
 		POLYMATH_UNUSED(edge_prev);
 		POLYMATH_UNUSED(edge_next);
 		assert(edge1.m_output_polygon != nullptr);
@@ -857,36 +1455,38 @@ public:
 	template<typename W>
 	Polygon<T, W> Result() {
 		Polygon<T, W> result;
+		ResultInto(result);
+		return result;
+	}
+
+	// Same as Result(), but replaces the contents of an existing polygon so its memory can be reused.
+	template<typename W>
+	void ResultInto(Polygon<T, W> &result) {
+		result.Clear();
 
 		// reserve space for all output vertices
 		// TODO: fix this
 		//result.vertices.reserve(m_output_vertex_batches.size() * OUTPUT_VERTEX_BATCH_SIZE + m_output_vertex_batch_used - OUTPUT_VERTEX_BATCH_SIZE);
 
 		// fill polygon with output vertex data
-		for(size_t i = 0; i < m_output_polygon_batches.size(); ++i) {
-			OutputPolygon *batch = m_output_polygon_batches[i].get();
-			size_t batch_size = (i == m_output_polygon_batches.size() - 1)? m_output_polygon_batch_used : OUTPUT_POLYGON_BATCH_SIZE;
-			for(size_t j = 0; j < batch_size; ++j) {
-				OutputPolygon *p = &batch[j];
-				result.AddVertex(p->m_stop_vertex);
-				OutputVertex *v = p->m_chain1;
-				while(v != nullptr) {
-					result.AddVertex(v->m_vertex);
-					v = v->m_next;
-				}
-				OutputVertex *w = p->m_chain2;
-				size_t rev = 0;
-				while(w->m_next != nullptr) {
-					result.AddVertex(w->m_vertex);
-					w = w->m_next;
-					++rev;
-				}
-				std::reverse(result.vertices.end() - rev, result.vertices.end());
-				result.AddLoopEnd(1);
+		ForEachPolygon([&](OutputPolygon *p) {
+			result.AddVertex(p->m_stop_vertex);
+			OutputVertex *v = p->m_chain1;
+			while(v != nullptr) {
+				result.AddVertex(v->m_vertex);
+				v = v->m_next;
 			}
-		}
+			OutputVertex *w = p->m_chain2;
+			size_t rev = 0;
+			while(w->m_next != nullptr) {
+				result.AddVertex(w->m_vertex);
+				w = w->m_next;
+				++rev;
+			}
+			std::reverse(result.vertices.end() - rev, result.vertices.end());
+			result.AddLoopEnd(1);
+		});
 
-		return result;
 	}
 
 };
@@ -918,6 +1518,7 @@ public:
 
 public:
 	static constexpr bool START_NEEDS_PREV_NEXT = true;
+	static constexpr bool START_ALWAYS_NEEDS_PREV_NEXT = false;
 	static constexpr bool STOP_NEEDS_PREV_NEXT = false;
 
 private:
@@ -925,15 +1526,30 @@ private:
 	static constexpr size_t OUTPUT_POLYGON_BATCH_SIZE = 256;
 
 private:
-	std::vector<std::unique_ptr<OutputVertex[]>> m_output_vertex_batches;
-	std::vector<std::unique_ptr<OutputPolygon[]>> m_output_polygon_batches;
+	bool m_delaunay;
+
+	std::vector<std::unique_ptr<OutputVertex[]>> m_output_vertex_batches, m_output_vertex_spare_batches;
+	std::vector<std::unique_ptr<OutputPolygon[]>> m_output_polygon_batches, m_output_polygon_spare_batches;
 	size_t m_output_vertex_batch_used, m_output_polygon_batch_used;
 
+	// temporary storage for the triangulation
+	std::vector<VertexType> m_front;
+
+	// temporary storage for the Delaunay flips
+	std::vector<VertexType> m_mesh_vertices;
+	std::vector<size_t> m_mesh_table, m_mesh_triangles, m_mesh_twins, m_mesh_edge_begin, m_mesh_edges, m_flip_stack;
+	std::vector<uint8_t> m_flip_queued;
+
 private:
 	OutputVertex* AddOutputVertex(VertexType vertex) {
 		if(m_output_vertex_batch_used == OUTPUT_VERTEX_BATCH_SIZE) {
-			std::unique_ptr<OutputVertex[]> mem(new OutputVertex[OUTPUT_VERTEX_BATCH_SIZE]);
-			m_output_vertex_batches.push_back(std::move(mem));
+			if(m_output_vertex_spare_batches.empty()) {
+				std::unique_ptr<OutputVertex[]> mem(new OutputVertex[OUTPUT_VERTEX_BATCH_SIZE]);
+				m_output_vertex_batches.push_back(std::move(mem));
+			} else {
+				m_output_vertex_batches.push_back(std::move(m_output_vertex_spare_batches.back()));
+				m_output_vertex_spare_batches.pop_back();
+			}
 			m_output_vertex_batch_used = 0;
 		}
 		OutputVertex *batch = m_output_vertex_batches.back().get();
@@ -945,8 +1561,13 @@ private:
 
 	OutputPolygon* AddOutputPolygon() {
 		if(m_output_polygon_batch_used == OUTPUT_POLYGON_BATCH_SIZE) {
-			std::unique_ptr<OutputPolygon[]> mem(new OutputPolygon[OUTPUT_POLYGON_BATCH_SIZE]);
-			m_output_polygon_batches.push_back(std::move(mem));
+			if(m_output_polygon_spare_batches.empty()) {
+				std::unique_ptr<OutputPolygon[]> mem(new OutputPolygon[OUTPUT_POLYGON_BATCH_SIZE]);
+				m_output_polygon_batches.push_back(std::move(mem));
+			} else {
+				m_output_polygon_batches.push_back(std::move(m_output_polygon_spare_batches.back()));
+				m_output_polygon_spare_batches.pop_back();
+			}
 			m_output_polygon_batch_used = 0;
 		}
 		OutputPolygon *batch = m_output_polygon_batches.back().get();
@@ -959,8 +1580,192 @@ private:
 		return NumericalEngine<T>::OrientationTest(a.x, a.y, b.x, b.y, c.x, c.y, false);
 	}
 
+	// Converts a list of triangles into an indexed mesh and flips every edge that isn't locally Delaunay until there
+	// are none left (Lawson's algorithm). Edges that don't have exactly one neighboring triangle on the other side
+	// are the constraints. Each flip is only done if both new triangles have a positive area, which also takes care
+	// of the degenerate triangles produced by collinear vertices. Every edge is checked once, and after a flip only
+	// the four surrounding edges are checked again. The triangles of the sweep are usually close to Delaunay already, so
+	// the number of flips is close to linear in practice, but like any flip algorithm it is quadratic in the worst case.
+	template<typename W>
+	void DelaunayFlip(Polygon<T, W> &result) {
+		size_t triangle_count = result.loops.size();
+		assert(result.vertices.size() == 3 * triangle_count);
+
+		// find the unique vertices with a hash table (open addressing, the size is doubled when it is half full)
+		size_t table_bits = 4;
+		while((size_t(1) << table_bits) < result.vertices.size() / 2) {
+			++table_bits;
+		}
+		auto Hash = [&table_bits](VertexType v) {
+			uint64_t h = uint64_t(std::hash<T>()(v.x)) * UINT64_C(0x9e3779b97f4a7c15) ^ uint64_t(std::hash<T>()(v.y));
+			return size_t((h * UINT64_C(0xc2b2ae3d27d4eb4f)) >> (64 - table_bits));
+		};
+		m_mesh_table.assign(size_t(1) << table_bits, INDEX_NONE);
+		m_mesh_vertices.clear();
+		m_mesh_triangles.resize(result.vertices.size());
+		for(size_t i = 0; i < result.vertices.size(); ++i) {
+			VertexType v = result.vertices[i];
+			size_t mask = m_mesh_table.size() - 1, slot = Hash(v);
+			while(m_mesh_table[slot] != INDEX_NONE && (m_mesh_vertices[m_mesh_table[slot]].x != v.x || m_mesh_vertices[m_mesh_table[slot]].y != v.y)) {
+				slot = (slot + 1) & mask;
+			}
+			size_t index = m_mesh_table[slot];
+			if(index == INDEX_NONE) {
+				index = m_mesh_vertices.size();
+				m_mesh_table[slot] = index;
+				m_mesh_vertices.push_back(v);
+				if(2 * m_mesh_vertices.size() > m_mesh_table.size()) {
+					++table_bits;
+					m_mesh_table.assign(size_t(1) << table_bits, INDEX_NONE);
+					for(size_t j = 0; j < m_mesh_vertices.size(); ++j) {
+						size_t slot2 = Hash(m_mesh_vertices[j]);
+						while(m_mesh_table[slot2] != INDEX_NONE) {
+							slot2 = (slot2 + 1) & (m_mesh_table.size() - 1);
+						}
+						m_mesh_table[slot2] = j;
+					}
+				}
+			}
+			m_mesh_triangles[i] = index;
+		}
+
+		// Group the half-edges by their lowest vertex and sort each group by the other vertex, so both halves of an edge
+		// end up next to each other (half-edge 3 * t + k goes from corner k to corner k + 1 of triangle t). Searching
+		// the edges of the origin instead would be quadratic for vertices that are shared by many triangles, e.g. the
+		// fans produced by combs.
+		auto Destination = [this](size_t edge) {
+			return m_mesh_triangles[(edge % 3 == 2)? edge - 2 : edge + 1];
+		};
+		m_mesh_edge_begin.assign(m_mesh_vertices.size() + 1, 0);
+		for(size_t i = 0; i < m_mesh_triangles.size(); ++i) {
+			++m_mesh_edge_begin[std::min(m_mesh_triangles[i], Destination(i)) + 1];
+		}
+		for(size_t i = 0; i < m_mesh_vertices.size(); ++i) {
+			m_mesh_edge_begin[i + 1] += m_mesh_edge_begin[i];
+		}
+		m_mesh_edges.resize(m_mesh_triangles.size());
+		for(size_t i = 0; i < m_mesh_triangles.size(); ++i) {
+			m_mesh_edges[m_mesh_edge_begin[std::min(m_mesh_triangles[i], Destination(i))]++] = i;
+		}
+		for(size_t i = m_mesh_vertices.size(); i > 0; --i) {
+			m_mesh_edge_begin[i] = m_mesh_edge_begin[i - 1];
+		}
+		m_mesh_edge_begin[0] = 0;
+		auto Other = [&](size_t edge) {
+			return std::max(m_mesh_triangles[edge], Destination(edge));
+		};
+		for(size_t i = 0; i < m_mesh_vertices.size(); ++i) {
+			std::sort(m_mesh_edges.begin() + m_mesh_edge_begin[i], m_mesh_edges.begin() + m_mesh_edge_begin[i + 1], [&](size_t e1, size_t e2) {
+				return Other(e1) < Other(e2);
+			});
+		}
+
+		// find the twins (edges that are shared by more than two triangles are treated as constraints)
+		m_mesh_twins.assign(m_mesh_triangles.size(), INDEX_NONE);
+		for(size_t i = 0; i < m_mesh_edges.size(); ) {
+			size_t j = i + 1;
+			while(j < m_mesh_edges.size() && std::min(m_mesh_triangles[m_mesh_edges[j]], Destination(m_mesh_edges[j])) ==
+					std::min(m_mesh_triangles[m_mesh_edges[i]], Destination(m_mesh_edges[i])) && Other(m_mesh_edges[j]) == Other(m_mesh_edges[i])) {
+				++j;
+			}
+			if(j - i == 2 && m_mesh_triangles[m_mesh_edges[i]] != m_mesh_triangles[m_mesh_edges[i + 1]]) {
+				m_mesh_twins[m_mesh_edges[i]] = m_mesh_edges[i + 1];
+				m_mesh_twins[m_mesh_edges[i + 1]] = m_mesh_edges[i];
+			}
+			i = j;
+		}
+		m_flip_stack.clear();
+		for(size_t i = 0; i < m_mesh_triangles.size(); ++i) {
+			if(m_mesh_twins[i] != INDEX_NONE && i < m_mesh_twins[i])
+				m_flip_stack.push_back(i);
+		}
+		m_flip_queued.assign(m_mesh_triangles.size(), 0);
+		for(size_t edge : m_flip_stack) {
+			m_flip_queued[edge] = 1;
+		}
+
+		// flip edges until all of them are locally Delaunay
+		while(!m_flip_stack.empty()) {
+			size_t edge1 = m_flip_stack.back();
+			m_flip_stack.pop_back();
+			m_flip_queued[edge1] = 0;
+			size_t edge2 = m_mesh_twins[edge1];
+			if(edge2 == INDEX_NONE)
+				continue;
+
+			// triangle (a, b, c) is on the left side of a -> b, triangle (b, a, d) is on the right side
+			size_t t1 = edge1 - edge1 % 3, t2 = edge2 - edge2 % 3;
+			size_t i1 = edge1 % 3, i2 = edge2 % 3;
+			size_t a = m_mesh_triangles[t1 + i1], b = m_mesh_triangles[t1 + (i1 + 1) % 3], c = m_mesh_triangles[t1 + (i1 + 2) % 3];
+			size_t d = m_mesh_triangles[t2 + (i2 + 2) % 3];
+			VertexType va = m_mesh_vertices[a], vb = m_mesh_vertices[b], vc = m_mesh_vertices[c], vd = m_mesh_vertices[d];
+			if(!NumericalEngine<T>::InCircleTest(va.x, va.y, vb.x, vb.y, vc.x, vc.y, vd.x, vd.y, true) ||
+					!NumericalEngine<T>::OrientationTest(va.x, va.y, vd.x, vd.y, vc.x, vc.y, true) ||
+					!NumericalEngine<T>::OrientationTest(vd.x, vd.y, vb.x, vb.y, vc.x, vc.y, true))
+				continue;
+
+			// replace the triangles with (a, d, c) and (d, b, c)
+			size_t twin_bc = m_mesh_twins[t1 + (i1 + 1) % 3], twin_ca = m_mesh_twins[t1 + (i1 + 2) % 3];
+			size_t twin_ad = m_mesh_twins[t2 + (i2 + 1) % 3], twin_db = m_mesh_twins[t2 + (i2 + 2) % 3];
+			m_mesh_triangles[t1] = a;
+			m_mesh_triangles[t1 + 1] = d;
+			m_mesh_triangles[t1 + 2] = c;
+			m_mesh_triangles[t2] = d;
+			m_mesh_triangles[t2 + 1] = b;
+			m_mesh_triangles[t2 + 2] = c;
+			auto Link = [this](size_t edge, size_t twin) {
+				m_mesh_twins[edge] = twin;
+				if(twin != INDEX_NONE)
+					m_mesh_twins[twin] = edge;
+			};
+			Link(t1, twin_ad);
+			Link(t1 + 1, t2 + 2);
+			Link(t1 + 2, twin_ca);
+			Link(t2, twin_db);
+			Link(t2 + 1, twin_bc);
+
+			// check the surrounding edges again
+			size_t check[4] = {t1, t1 + 2, t2, t2 + 1};
+			for(size_t edge : check) {
+				size_t twin = m_mesh_twins[edge];
+				if(twin != INDEX_NONE && !m_flip_queued[edge] && !m_flip_queued[twin]) {
+					m_flip_queued[edge] = 1;
+					m_flip_stack.push_back(edge);
+				}
+			}
+
+		}
+
+		// generate the output
+		result.Clear();
+		for(size_t i = 0; i < triangle_count; ++i) {
+			result.AddVertex(m_mesh_vertices[m_mesh_triangles[3 * i]]);
+			result.AddVertex(m_mesh_vertices[m_mesh_triangles[3 * i + 1]]);
+			result.AddVertex(m_mesh_vertices[m_mesh_triangles[3 * i + 2]]);
+			result.AddLoopEnd(1);
+		}
+
+	}
+
 public:
-	OutputPolicy_Triangles() {
+	// If delaunay is true, the triangulation is converted into a constrained Delaunay triangulation with edge flips,
+	// where the boundaries of the output are the constraints. This avoids most of the thin triangles.
+	explicit OutputPolicy_Triangles(bool delaunay = false) {
+		m_delaunay = delaunay;
+		m_output_vertex_batch_used = OUTPUT_VERTEX_BATCH_SIZE;
+		m_output_polygon_batch_used = OUTPUT_POLYGON_BATCH_SIZE;
+	}
+
+	// Discards all output but keeps the allocated memory so it can be reused.
+	void Reset() {
+		for(auto &batch : m_output_vertex_batches) {
+			m_output_vertex_spare_batches.push_back(std::move(batch));
+		}
+		m_output_vertex_batches.clear();
+		for(auto &batch : m_output_polygon_batches) {
+			m_output_polygon_spare_batches.push_back(std::move(batch));
+		}
+		m_output_polygon_batches.clear();
 		m_output_vertex_batch_used = OUTPUT_VERTEX_BATCH_SIZE;
 		m_output_polygon_batch_used = OUTPUT_POLYGON_BATCH_SIZE;
 	}
@@ -1098,6 +1903,7 @@ public:
 	}
 
 	void OutputMiddleVertex(OutputEdge &edge, VertexType vertex, bool is_left) {
+		POLYMATH_UNUSED(is_left);
 		assert(edge.m_output_polygon != nullptr);
 
 		if(edge.m_output_forward) {
@@ -1139,6 +1945,7 @@ public:
 	}
 
 	void OutputStopVertex(OutputEdge &edge1, OutputEdge &edge2, VertexType vertex, bool is_merge, OutputEdge *edge_prev, OutputEdge *edge_next) {
+		POLYMATH_UNUSED(is_merge);
 		POLYMATH_UNUSED(edge_prev);
 		POLYMATH_UNUSED(edge_next);
 		assert(edge1.m_output_polygon != nullptr);
@@ -1215,7 +2022,15 @@ public:
 	template<typename W>
 	Polygon<T, W> Result() {
 		Polygon<T, W> result;
-		std::vector<VertexType> front;
+		ResultInto(result);
+		return result;
+	}
+
+	// Same as Result(), but replaces the contents of an existing polygon so its memory can be reused.
+	template<typename W>
+	void ResultInto(Polygon<T, W> &result) {
+		result.Clear();
+		std::vector<VertexType> &front = m_front;
 
 		// fill polygon with output vertex data
 		for(size_t i = 0; i < m_output_polygon_batches.size(); ++i) {
@@ -1303,9 +2118,1454 @@ public:
 			}
 		}
 
+		if(m_delaunay)
+			DelaunayFlip(result);
+
+	}
+
+};
+
+// Generates a convex partition with the Hertel-Mehlhorn algorithm, on top of the sweep of OutputPolicy_Monotone.
+// Every monotone polygon is triangulated in linear time, and every triangle is merged with its neighbors as soon as
+// they exist if the result is still convex. Afterwards, the same is done for the diagonals between the monotone
+// polygons, which are found by matching boundary edges that have the same vertices in the opposite direction. A
+// diagonal that can't be removed when it is checked can't be removed later either, because the angles of the pieces
+// only grow, so in the end no two pieces can be merged. This guarantees that there are at most four times as many
+// pieces as in a minimal convex partition, and in practice there are about half as many pieces as triangles. Triangles
+// with zero area (or that were inverted by rounding) are handled like in OutputPolicy_Triangles, but they are never
+// merged, and pieces that end up with zero area are dropped.
+template<typename T>
+class OutputPolicy_Convex : public OutputPolicy_Monotone<T> {
+
+public:
+	typedef T ValueType;
+	typedef Vertex<T> VertexType;
+
+private:
+	typedef OutputPolicy_Monotone<T> Base;
+	typedef typename Base::OutputVertex OutputVertex;
+	typedef typename Base::OutputPolygon OutputPolygon;
+
+	// nodes of the circular vertex lists of the convex pieces, each node owns the edge to the next node
+	struct Node {
+		size_t m_vertex, m_prev, m_next, m_piece;
+	};
+
+private:
+	// temporary storage for the partition
+	std::vector<VertexType> m_vertices;
+	std::vector<Node> m_nodes;
+	std::vector<size_t> m_piece_parents, m_piece_nodes, m_boundary_nodes, m_front, m_front_edges;
+	std::vector<uint8_t> m_piece_degenerate;
+
+private:
+	static bool OrientationTest(VertexType a, VertexType b, VertexType c, bool strict) {
+		return NumericalEngine<T>::OrientationTest(a.x, a.y, b.x, b.y, c.x, c.y, strict);
+	}
+
+	// returns whether b is a convex (or straight) vertex of a clockwise loop
+	static bool IsConvex(VertexType a, VertexType b, VertexType c) {
+		return !OrientationTest(a, b, c, false) || OutputVertexIsRedundant(a, b, c);
+	}
+
+	size_t FindPiece(size_t piece) {
+		while(m_piece_parents[piece] != piece) {
+			m_piece_parents[piece] = m_piece_parents[m_piece_parents[piece]];
+			piece = m_piece_parents[piece];
+		}
+		return piece;
+	}
+
+	// Adds a clockwise triangle as a new piece and returns the node of the first vertex. Triangles that have zero area
+	// or that were inverted by rounding are never merged, since the convexity test doesn't work for them.
+	size_t AddTriangle(size_t a, size_t b, size_t c) {
+		size_t node = m_nodes.size(), piece = m_piece_parents.size();
+		m_nodes.push_back(Node{a, node + 2, node + 1, piece});
+		m_nodes.push_back(Node{b, node, node + 2, piece});
+		m_nodes.push_back(Node{c, node + 1, node, piece});
+		m_piece_parents.push_back(piece);
+		m_piece_nodes.push_back(node);
+		m_piece_degenerate.push_back(OrientationTest(m_vertices[a], m_vertices[b], m_vertices[c], false));
+		return node;
+	}
+
+	// Handles an edge of a new triangle. If the piece on the other side already exists, the pieces are merged if the
+	// result is convex. Otherwise the edge is on the boundary of the monotone polygon, and it is stored so it can be
+	// matched with the other side later if it is a diagonal.
+	void LinkEdge(size_t node, size_t other) {
+		if(other == INDEX_NONE) {
+			m_boundary_nodes.push_back(node);
+		} else {
+			MergePieces(node, other);
+		}
+	}
+
+	// Removes the diagonal between two pieces if the result is convex. Node 'a' owns the edge u -> v and node 'b'
+	// owns the edge v -> u. Both nodes are removed, the other nodes keep their edges.
+	void MergePieces(size_t a, size_t b) {
+		Node &node_a = m_nodes[a], &node_b = m_nodes[b];
+		size_t piece_a = FindPiece(node_a.m_piece), piece_b = FindPiece(node_b.m_piece);
+		if(piece_a == piece_b || m_piece_degenerate[piece_a] || m_piece_degenerate[piece_b])
+			return;
+		size_t prev_a = node_a.m_prev, next_a = node_a.m_next;
+		size_t prev_b = node_b.m_prev, next_b = node_b.m_next;
+		if(!IsConvex(m_vertices[m_nodes[prev_a].m_vertex], m_vertices[node_a.m_vertex], m_vertices[m_nodes[m_nodes[next_b].m_next].m_vertex]))
+			return;
+		if(!IsConvex(m_vertices[m_nodes[prev_b].m_vertex], m_vertices[node_b.m_vertex], m_vertices[m_nodes[m_nodes[next_a].m_next].m_vertex]))
+			return;
+		m_nodes[prev_a].m_next = next_b;
+		m_nodes[next_b].m_prev = prev_a;
+		m_nodes[prev_b].m_next = next_a;
+		m_nodes[next_a].m_prev = prev_b;
+		m_piece_parents[piece_b] = piece_a;
+		m_piece_nodes[piece_a] = next_b;
+	}
+
+	// Adds the vertices of a monotone polygon to m_vertices, in the same order as OutputPolicy_Monotone. Duplicate
+	// vertices are removed. Returns the index of the start vertex.
+	size_t AddMonotoneVertices(OutputPolygon *p) {
+		size_t begin = m_vertices.size();
+		auto AddVertex = [&](VertexType vertex) {
+			if(m_vertices.size() == begin || m_vertices.back().x != vertex.x || m_vertices.back().y != vertex.y)
+				m_vertices.push_back(vertex);
+		};
+		AddVertex(p->m_stop_vertex);
+		for(OutputVertex *v = p->m_chain1; v != nullptr; v = v->m_next) {
+			AddVertex(v->m_vertex);
+		}
+		size_t start = m_vertices.size() - 1, middle = m_vertices.size();
+		for(OutputVertex *w = p->m_chain2; w->m_next != nullptr; w = w->m_next) {
+			m_vertices.push_back(w->m_vertex);
+		}
+		std::reverse(m_vertices.begin() + middle, m_vertices.end());
+		size_t end = middle;
+		for(size_t i = middle; i < m_vertices.size(); ++i) {
+			if(m_vertices[i].x != m_vertices[end - 1].x || m_vertices[i].y != m_vertices[end - 1].y)
+				m_vertices[end++] = m_vertices[i];
+		}
+		while(end > begin + 1 && m_vertices[end - 1].x == m_vertices[begin].x && m_vertices[end - 1].y == m_vertices[begin].y) {
+			--end;
+		}
+		m_vertices.resize(end);
+		return start;
+	}
+
+	// Triangulates a monotone polygon with the same algorithm as OutputPolicy_Triangles, and merges the triangles on the
+	// fly.
+	void PartitionMonotonePolygon(OutputPolygon *polygon) {
+		size_t begin = m_vertices.size();
+		size_t start = AddMonotoneVertices(polygon);
+		size_t end = m_vertices.size();
+		if(end - begin < 3 || start == begin || start >= end)
+			return;
+
+		// adds a fan from 'p' to all vertices of the front, on either side
+		auto AddFan = [&](size_t p, bool bottom, bool last_boundary) {
+			size_t shared = INDEX_NONE;
+			for(size_t i = 0; i < m_front.size() - 1; ++i) {
+				size_t node;
+				if(bottom) {
+					node = AddTriangle(p, m_front[i + 1], m_front[i]);
+					LinkEdge(node + 1, m_front_edges[i]);
+					LinkEdge(node + 2, shared);
+					shared = node;
+				} else {
+					node = AddTriangle(p, m_front[i], m_front[i + 1]);
+					LinkEdge(node, shared);
+					LinkEdge(node + 1, m_front_edges[i]);
+					shared = node + 2;
+				}
+			}
+			if(last_boundary)
+				LinkEdge(shared, INDEX_NONE);
+			return shared;
+		};
+
+		size_t chain1 = begin + 1, chain2 = end - 1;
+		bool fronttop = true;
+		m_front.clear();
+		m_front_edges.clear();
+		m_front.push_back(begin);
+		while(chain1 != start || chain2 != start) {
+			VertexType p1 = m_vertices[chain1];
+			VertexType p2 = m_vertices[chain2];
+			if(chain2 == start || (chain1 != start && p1.x > p2.x)) {
+				if(fronttop) {
+					size_t shared = AddFan(chain1, true, false);
+					size_t temp = m_front.back();
+					m_front.clear();
+					m_front.push_back(temp);
+					m_front.push_back(chain1);
+					m_front_edges.assign(1, shared);
+					fronttop = false;
+				} else {
+					size_t pending = INDEX_NONE;
+					while(m_front.size() > 1 && OrientationTest(p1, m_vertices[*(m_front.end() - 1)], m_vertices[*(m_front.end() - 2)], false)) {
+						size_t node = AddTriangle(chain1, *(m_front.end() - 2), *(m_front.end() - 1));
+						LinkEdge(node + 1, m_front_edges.back());
+						LinkEdge(node + 2, pending);
+						pending = node;
+						m_front.pop_back();
+						m_front_edges.pop_back();
+					}
+					m_front.push_back(chain1);
+					m_front_edges.push_back(pending);
+				}
+				++chain1;
+			} else {
+				if(!fronttop) {
+					size_t shared = AddFan(chain2, false, false);
+					size_t temp = m_front.back();
+					m_front.clear();
+					m_front.push_back(temp);
+					m_front.push_back(chain2);
+					m_front_edges.assign(1, shared);
+					fronttop = true;
+				} else {
+					size_t pending = INDEX_NONE;
+					while(m_front.size() > 1 && OrientationTest(p2, m_vertices[*(m_front.end() - 2)], m_vertices[*(m_front.end() - 1)], false)) {
+						size_t node = AddTriangle(chain2, *(m_front.end() - 1), *(m_front.end() - 2));
+						LinkEdge(node, pending);
+						LinkEdge(node + 1, m_front_edges.back());
+						pending = node + 2;
+						m_front.pop_back();
+						m_front_edges.pop_back();
+					}
+					m_front.push_back(chain2);
+					m_front_edges.push_back(pending);
+				}
+				--chain2;
+			}
+		}
+		AddFan(start, fronttop, true);
+
+	}
+
+	// Removes the diagonals between the monotone polygons. The boundary edges are sorted by their lowest and highest
+	// vertex, and a group of two edges in opposite directions is a diagonal. Edges that overlap in any other way (which
+	// can only happen for degenerate input) are left alone.
+	void MergeMonotonePolygons() {
+		auto EdgeKey = [&](size_t node, bool high) {
+			VertexType u = m_vertices[m_nodes[node].m_vertex], v = m_vertices[m_nodes[m_nodes[node].m_next].m_vertex];
+			return ((u.x < v.x || (u.x == v.x && u.y < v.y)) != high)? u : v;
+		};
+		auto EdgeLess = [&](size_t a, size_t b) {
+			VertexType a1 = EdgeKey(a, false), b1 = EdgeKey(b, false);
+			if(a1.x != b1.x)
+				return a1.x < b1.x;
+			if(a1.y != b1.y)
+				return a1.y < b1.y;
+			VertexType a2 = EdgeKey(a, true), b2 = EdgeKey(b, true);
+			return (a2.x < b2.x || (a2.x == b2.x && a2.y < b2.y));
+		};
+		std::sort(m_boundary_nodes.begin(), m_boundary_nodes.end(), EdgeLess);
+		for(size_t i = 0; i < m_boundary_nodes.size(); ) {
+			size_t j = i + 1;
+			while(j < m_boundary_nodes.size() && !EdgeLess(m_boundary_nodes[i], m_boundary_nodes[j])) {
+				++j;
+			}
+			if(j - i == 2) {
+				size_t a = m_boundary_nodes[i], b = m_boundary_nodes[i + 1];
+				if(m_vertices[m_nodes[a].m_vertex].x == m_vertices[m_nodes[m_nodes[b].m_next].m_vertex].x &&
+						m_vertices[m_nodes[a].m_vertex].y == m_vertices[m_nodes[m_nodes[b].m_next].m_vertex].y)
+					MergePieces(a, b);
+			}
+			i = j;
+		}
+	}
+
+public:
+	template<typename W>
+	Polygon<T, W> Result() {
+		Polygon<T, W> result;
+		ResultInto(result);
 		return result;
 	}
 
+	// Same as Result(), but replaces the contents of an existing polygon so its memory can be reused.
+	template<typename W>
+	void ResultInto(Polygon<T, W> &result) {
+		result.Clear();
+
+		// partition the monotone polygons
+		m_vertices.clear();
+		m_nodes.clear();
+		m_piece_parents.clear();
+		m_piece_nodes.clear();
+		m_piece_degenerate.clear();
+		m_boundary_nodes.clear();
+		this->ForEachPolygon([&](OutputPolygon *p) {
+			PartitionMonotonePolygon(p);
+		});
+		MergeMonotonePolygons();
+
+		// generate the output, without straight vertices
+		for(size_t piece = 0; piece < m_piece_parents.size(); ++piece) {
+			if(m_piece_parents[piece] != piece)
+				continue;
+			size_t first = m_piece_nodes[piece], node = first, count = 0;
+			do {
+				const Node &current = m_nodes[node];
+				VertexType vertex = m_vertices[current.m_vertex];
+				if(!OutputVertexIsRedundant(m_vertices[m_nodes[current.m_prev].m_vertex], vertex, m_vertices[m_nodes[current.m_next].m_vertex])) {
+					result.AddVertex(vertex);
+					++count;
+				}
+				node = current.m_next;
+			} while(node != first);
+			if(count < 3) {
+				result.vertices.resize(result.vertices.size() - count);
+			} else {
+				result.AddLoopEnd(1);
+			}
+		}
+
+	}
+
+};
+
+// Generates a trapezoidal decomposition directly from the sweep events. Every filled region between two output edges
+// keeps the X coordinate of the last event that touched it. When a vertex is added to one of its bounding edges, or
+// when the region is split or merged, the trapezoid between that X coordinate and the current one is emitted and a new
+// one starts. The bounding edges don't change within a trapezoid, so it is stored as a pair of output segments. The end
+// of a segment is only known after the next vertex of that edge, so the Y coordinates are calculated afterwards. Every
+// trapezoid has two vertical sides (which may have zero length) and is output as a clockwise loop. The Y coordinates are
+// interpolated in double precision and are not rounded, so the trapezoids tile the output exactly (up to floating point
+// error) even for integer types.
+template<typename T>
+class OutputPolicy_Trapezoids {
+
+public:
+	typedef T ValueType;
+	typedef Vertex<T> VertexType;
+
+	// A trapezoid between x1 and x2, bounded by the lower and upper Y coordinates at both sides. The Y coordinates are
+	// the exact positions of the bounding output edges. Rounding of intersections can make the bounding edges cross
+	// slightly, in that case the upper coordinate is below the lower one and the trapezoid has a small negative area.
+	struct Trapezoid {
+		T x1, x2;
+		double y1_lower, y1_upper, y2_lower, y2_upper;
+	};
+
+private:
+	struct OutputSegment {
+		VertexType m_vertex1, m_vertex2;
+	};
+	struct OutputRegion {
+		T m_x;
+		OutputSegment *m_lower, *m_upper;
+	};
+	struct OutputTrapezoid {
+		T m_x1, m_x2;
+		OutputSegment *m_lower, *m_upper;
+	};
+
+public:
+	struct OutputEdge {
+		OutputSegment *m_output_segment;
+		OutputRegion *m_output_region;
+	};
+
+public:
+	static constexpr bool START_NEEDS_PREV_NEXT = true;
+	static constexpr bool START_ALWAYS_NEEDS_PREV_NEXT = false;
+	static constexpr bool STOP_NEEDS_PREV_NEXT = true;
+
+private:
+	static constexpr size_t OUTPUT_SEGMENT_BATCH_SIZE = 256;
+	static constexpr size_t OUTPUT_REGION_BATCH_SIZE = 256;
+
+private:
+	std::vector<std::unique_ptr<OutputSegment[]>> m_output_segment_batches, m_output_segment_spare_batches;
+	std::vector<std::unique_ptr<OutputRegion[]>> m_output_region_batches, m_output_region_spare_batches;
+	size_t m_output_segment_batch_used, m_output_region_batch_used;
+
+	std::vector<OutputTrapezoid> m_output_trapezoids;
+
+private:
+	OutputSegment* AddOutputSegment(VertexType vertex) {
+		if(m_output_segment_batch_used == OUTPUT_SEGMENT_BATCH_SIZE) {
+			if(m_output_segment_spare_batches.empty()) {
+				std::unique_ptr<OutputSegment[]> mem(new OutputSegment[OUTPUT_SEGMENT_BATCH_SIZE]);
+				m_output_segment_batches.push_back(std::move(mem));
+			} else {
+				m_output_segment_batches.push_back(std::move(m_output_segment_spare_batches.back()));
+				m_output_segment_spare_batches.pop_back();
+			}
+			m_output_segment_batch_used = 0;
+		}
+		OutputSegment *batch = m_output_segment_batches.back().get();
+		OutputSegment *s = &batch[m_output_segment_batch_used];
+		s->m_vertex1 = vertex;
+		s->m_vertex2 = vertex;
+		++m_output_segment_batch_used;
+		return s;
+	}
+
+	OutputRegion* AddOutputRegion(T x, OutputSegment *lower, OutputSegment *upper) {
+		if(m_output_region_batch_used == OUTPUT_REGION_BATCH_SIZE) {
+			if(m_output_region_spare_batches.empty()) {
+				std::unique_ptr<OutputRegion[]> mem(new OutputRegion[OUTPUT_REGION_BATCH_SIZE]);
+				m_output_region_batches.push_back(std::move(mem));
+			} else {
+				m_output_region_batches.push_back(std::move(m_output_region_spare_batches.back()));
+				m_output_region_spare_batches.pop_back();
+			}
+			m_output_region_batch_used = 0;
+		}
+		OutputRegion *batch = m_output_region_batches.back().get();
+		OutputRegion *r = &batch[m_output_region_batch_used];
+		r->m_x = x;
+		r->m_lower = lower;
+		r->m_upper = upper;
+		++m_output_region_batch_used;
+		return r;
+	}
+
+	// emits the trapezoid between the last event of the region and x (if it isn't empty)
+	void CloseTrapezoid(OutputRegion *region, T x) {
+		assert(x >= region->m_x);
+		if(x > region->m_x)
+			m_output_trapezoids.push_back(OutputTrapezoid{region->m_x, x, region->m_lower, region->m_upper});
+		region->m_x = x;
+	}
+
+	static double SegmentY(const OutputSegment *segment, T x) {
+		VertexType a = segment->m_vertex1, b = segment->m_vertex2;
+		if(x == a.x)
+			return double(a.y);
+		if(x == b.x)
+			return double(b.y);
+		double t = (double(x) - double(a.x)) / (double(b.x) - double(a.x));
+		return double(a.y) + (double(b.y) - double(a.y)) * t;
+	}
+
+	static Trapezoid MakeTrapezoid(const OutputTrapezoid &t) {
+		return Trapezoid{t.m_x1, t.m_x2, SegmentY(t.m_lower, t.m_x1), SegmentY(t.m_upper, t.m_x1), SegmentY(t.m_lower, t.m_x2), SegmentY(t.m_upper, t.m_x2)};
+	}
+
+public:
+	OutputPolicy_Trapezoids() {
+		m_output_segment_batch_used = OUTPUT_SEGMENT_BATCH_SIZE;
+		m_output_region_batch_used = OUTPUT_REGION_BATCH_SIZE;
+	}
+
+	// Discards all output but keeps the allocated memory so it can be reused.
+	void Reset() {
+		for(auto &batch : m_output_segment_batches) {
+			m_output_segment_spare_batches.push_back(std::move(batch));
+		}
+		m_output_segment_batches.clear();
+		for(auto &batch : m_output_region_batches) {
+			m_output_region_spare_batches.push_back(std::move(batch));
+		}
+		m_output_region_batches.clear();
+		m_output_segment_batch_used = OUTPUT_SEGMENT_BATCH_SIZE;
+		m_output_region_batch_used = OUTPUT_REGION_BATCH_SIZE;
+		m_output_trapezoids.clear();
+	}
+
+	static bool HasOutputEdge(OutputEdge &edge) {
+		return (edge.m_output_segment != nullptr);
+	}
+
+	static void ClearOutputEdge(OutputEdge &edge) {
+		edge.m_output_segment = nullptr;
+	}
+
+	static void CopyOutputEdge(OutputEdge &from, OutputEdge &to) {
+		to.m_output_segment = from.m_output_segment;
+		to.m_output_region = from.m_output_region;
+	}
+
+	static void SwapOutputEdges(OutputEdge &edge1, OutputEdge &edge2) {
+		std::swap(edge1.m_output_segment, edge2.m_output_segment);
+		std::swap(edge1.m_output_region, edge2.m_output_region);
+	}
+
+	void OutputStartVertex(OutputEdge &edge1, OutputEdge &edge2, VertexType vertex, bool is_split, OutputEdge *edge_prev, OutputEdge *edge_next) {
+
+		// create new output segments
+		OutputSegment *output_segment1 = AddOutputSegment(vertex);
+		OutputSegment *output_segment2 = AddOutputSegment(vertex);
+
+		if(is_split) {
+
+			// close the trapezoid of the existing region
+			OutputRegion *output_region1 = edge_prev->m_output_region;
+			assert(output_region1 == edge_next->m_output_region);
+			CloseTrapezoid(output_region1, vertex.x);
+
+			// split the region (edge1 is now the upper edge of the lower half)
+			OutputRegion *output_region2 = AddOutputRegion(vertex.x, output_segment2, output_region1->m_upper);
+			output_region1->m_upper = output_segment1;
+
+			// update edges
+			edge1.m_output_segment = output_segment1;
+			edge1.m_output_region = output_region1;
+			edge2.m_output_segment = output_segment2;
+			edge2.m_output_region = output_region2;
+			edge_next->m_output_region = output_region2;
+
+		} else {
+
+			// create new output region
+			OutputRegion *output_region = AddOutputRegion(vertex.x, output_segment1, output_segment2);
+
+			// update edges
+			edge1.m_output_segment = output_segment1;
+			edge1.m_output_region = output_region;
+			edge2.m_output_segment = output_segment2;
+			edge2.m_output_region = output_region;
+
+		}
+
+	}
+
+	void OutputMiddleVertex(OutputEdge &edge, VertexType vertex, bool is_left) {
+		POLYMATH_UNUSED(is_left);
+		assert(edge.m_output_segment != nullptr);
+
+		// close the trapezoid and the segment
+		OutputRegion *output_region = edge.m_output_region;
+		CloseTrapezoid(output_region, vertex.x);
+		edge.m_output_segment->m_vertex2 = vertex;
+
+		// start a new segment
+		OutputSegment *output_segment = AddOutputSegment(vertex);
+		if(output_region->m_lower == edge.m_output_segment) {
+			output_region->m_lower = output_segment;
+		} else {
+			assert(output_region->m_upper == edge.m_output_segment);
+			output_region->m_upper = output_segment;
+		}
+		edge.m_output_segment = output_segment;
+
+	}
+
+	void OutputStopVertex(OutputEdge &edge1, OutputEdge &edge2, VertexType vertex, bool is_merge, OutputEdge *edge_prev, OutputEdge *edge_next) {
+		POLYMATH_UNUSED(edge_prev);
+		assert(edge1.m_output_segment != nullptr);
+		assert(edge2.m_output_segment != nullptr);
+
+		// close the segments
+		edge1.m_output_segment->m_vertex2 = vertex;
+		edge2.m_output_segment->m_vertex2 = vertex;
+
+		if(is_merge) {
+
+			// close the trapezoids of both regions (edge1 is the upper edge of the lower region)
+			OutputRegion *output_region1 = edge1.m_output_region, *output_region2 = edge2.m_output_region;
+			assert(output_region2 == edge_next->m_output_region);
+			CloseTrapezoid(output_region1, vertex.x);
+			CloseTrapezoid(output_region2, vertex.x);
+
+			// merge the regions
+			output_region1->m_upper = output_region2->m_upper;
+			edge_next->m_output_region = output_region1;
+
+		} else {
+
+			assert(edge1.m_output_region == edge2.m_output_region);
+			CloseTrapezoid(edge1.m_output_region, vertex.x);
+
+		}
+
+	}
+
+	void Visualize(Visualization<T> &vis) {
+
+		// output edges
+		for(size_t i = 0; i < m_output_segment_batches.size(); ++i) {
+			OutputSegment *batch = m_output_segment_batches[i].get();
+			size_t batch_size = (i == m_output_segment_batches.size() - 1)? m_output_segment_batch_used : OUTPUT_SEGMENT_BATCH_SIZE;
+			for(size_t j = 0; j < batch_size; ++j) {
+				OutputSegment *s = &batch[j];
+				if(s->m_vertex1.x != s->m_vertex2.x || s->m_vertex1.y != s->m_vertex2.y) {
+					vis.m_output_edges.emplace_back();
+					auto &edge = vis.m_output_edges.back();
+					edge.m_edge_vertices[0] = s->m_vertex1;
+					edge.m_edge_vertices[1] = s->m_vertex2;
+				}
+			}
+		}
+
+	}
+
+	std::vector<Trapezoid> ResultTrapezoids() {
+		std::vector<Trapezoid> trapezoids;
+		ResultTrapezoidsInto(trapezoids);
+		return trapezoids;
+	}
+
+	// Same as ResultTrapezoids(), but reuses the memory of an existing vector.
+	void ResultTrapezoidsInto(std::vector<Trapezoid> &trapezoids) {
+		trapezoids.resize(m_output_trapezoids.size());
+		for(size_t i = 0; i < m_output_trapezoids.size(); ++i) {
+			trapezoids[i] = MakeTrapezoid(m_output_trapezoids[i]);
+		}
+	}
+
+	template<typename W>
+	Polygon<T, W> Result() {
+		Polygon<T, W> result;
+		ResultInto(result);
+		return result;
+	}
+
+	// Same as Result(), but replaces the contents of an existing polygon so its memory can be reused. The Y coordinates
+	// are rounded to the nearest coordinate for integer types, so unlike ResultTrapezoids() the loops don't tile the
+	// output exactly. A side that is inverted by rounding is reduced to a point, so trapezoids that are reduced to a
+	// triangle have three vertices. Trapezoids where both sides are reduced to a point are dropped.
+	template<typename W>
+	void ResultInto(Polygon<T, W> &result) {
+		result.Clear();
+		result.vertices.reserve(m_output_trapezoids.size() * 4);
+		result.loops.reserve(m_output_trapezoids.size());
+		for(const OutputTrapezoid &output_trapezoid : m_output_trapezoids) {
+			Trapezoid t = MakeTrapezoid(output_trapezoid);
+			T y1_lower = ConvertFromDouble<T>(t.y1_lower), y1_upper = std::max(ConvertFromDouble<T>(t.y1_upper), y1_lower);
+			T y2_lower = ConvertFromDouble<T>(t.y2_lower), y2_upper = std::max(ConvertFromDouble<T>(t.y2_upper), y2_lower);
+			if(y1_upper == y1_lower && y2_upper == y2_lower)
+				continue;
+			result.AddVertex(VertexType(t.x1, y1_lower));
+			if(y1_upper != y1_lower)
+				result.AddVertex(VertexType(t.x1, y1_upper));
+			result.AddVertex(VertexType(t.x2, y2_upper));
+			if(y2_lower != y2_upper)
+				result.AddVertex(VertexType(t.x2, y2_lower));
+			result.AddLoopEnd(1);
+		}
+	}
+
+};
+
+template<typename T>
+class OutputPolicy_Measure {
+
+public:
+	typedef T ValueType;
+	typedef Vertex<T> VertexType;
+	typedef typename NumericalEngine<T>::AccumulatorType AccumulatorType;
+
+private:
+	struct StartVertex {
+		StartVertex *m_parent;
+		size_t m_size;
+	};
+
+public:
+	struct OutputEdge {
+		VertexType m_vertex;
+		StartVertex *m_start_vertex;
+	};
+
+public:
+	static constexpr bool START_NEEDS_PREV_NEXT = false;
+	static constexpr bool START_ALWAYS_NEEDS_PREV_NEXT = false;
+	static constexpr bool STOP_NEEDS_PREV_NEXT = false;
+
+private:
+	static constexpr size_t START_VERTEX_BATCH_SIZE = 256;
+
+private:
+	std::vector<std::unique_ptr<StartVertex[]>> m_start_vertex_batches, m_start_vertex_spare_batches;
+	size_t m_start_vertex_batch_used;
+
+	AccumulatorType m_area, m_moment_x, m_moment_y;
+	double m_perimeter;
+	size_t m_outer_loop_count, m_hole_loop_count;
+
+private:
+	StartVertex* AddStartVertex() {
+		if(m_start_vertex_batch_used == START_VERTEX_BATCH_SIZE) {
+			if(m_start_vertex_spare_batches.empty()) {
+				std::unique_ptr<StartVertex[]> mem(new StartVertex[START_VERTEX_BATCH_SIZE]);
+				m_start_vertex_batches.push_back(std::move(mem));
+			} else {
+				m_start_vertex_batches.push_back(std::move(m_start_vertex_spare_batches.back()));
+				m_start_vertex_spare_batches.pop_back();
+			}
+			m_start_vertex_batch_used = 0;
+		}
+		StartVertex *batch = m_start_vertex_batches.back().get();
+		StartVertex *v = &batch[m_start_vertex_batch_used];
+		v->m_parent = nullptr;
+		v->m_size = 1;
+		++m_start_vertex_batch_used;
+		return v;
+	}
+
+	// iterative with path halving, since the trees can get deep for loops with many start vertices
+	StartVertex *FindStartVertexRoot(StartVertex *vertex) {
+		assert(vertex != nullptr);
+		while(vertex->m_parent != nullptr) {
+			if(vertex->m_parent->m_parent != nullptr)
+				vertex->m_parent = vertex->m_parent->m_parent;
+			vertex = vertex->m_parent;
+		}
+		return vertex;
+	}
+
+	void AddEdge(VertexType a, VertexType b) {
+		NumericalEngine<T>::AccumulateEdge(a.x, a.y, b.x, b.y, m_area, m_moment_x, m_moment_y);
+		m_perimeter += std::sqrt(Square(double(b.x) - double(a.x)) + Square(double(b.y) - double(a.y)));
+	}
+
+public:
+	OutputPolicy_Measure() {
+		m_start_vertex_batch_used = START_VERTEX_BATCH_SIZE;
+		m_perimeter = 0.0;
+		m_outer_loop_count = 0;
+		m_hole_loop_count = 0;
+	}
+
+	// Discards all output but keeps the allocated memory so it can be reused.
+	void Reset() {
+		for(auto &batch : m_start_vertex_batches) {
+			m_start_vertex_spare_batches.push_back(std::move(batch));
+		}
+		m_start_vertex_batches.clear();
+		m_start_vertex_batch_used = START_VERTEX_BATCH_SIZE;
+		m_area = AccumulatorType();
+		m_moment_x = AccumulatorType();
+		m_moment_y = AccumulatorType();
+		m_perimeter = 0.0;
+		m_outer_loop_count = 0;
+		m_hole_loop_count = 0;
+	}
+
+	static bool HasOutputEdge(OutputEdge &edge) {
+		return (edge.m_start_vertex != nullptr);
+	}
+
+	static void ClearOutputEdge(OutputEdge &edge) {
+		edge.m_start_vertex = nullptr;
+	}
+
+	static void CopyOutputEdge(OutputEdge &from, OutputEdge &to) {
+		to.m_vertex = from.m_vertex;
+		to.m_start_vertex = from.m_start_vertex;
+	}
+
+	static void SwapOutputEdges(OutputEdge &edge1, OutputEdge &edge2) {
+		std::swap(edge1.m_vertex, edge2.m_vertex);
+		std::swap(edge1.m_start_vertex, edge2.m_start_vertex);
+	}
+
+	void OutputStartVertex(OutputEdge &edge1, OutputEdge &edge2, VertexType vertex, bool is_split, OutputEdge *edge_prev, OutputEdge *edge_next) {
+		POLYMATH_UNUSED(is_split);
+		POLYMATH_UNUSED(edge_prev);
+		POLYMATH_UNUSED(edge_next);
+
+		// create new start vertex
+		StartVertex *start_vertex = AddStartVertex();
+
+		// update edges
+		edge1.m_vertex = vertex;
+		edge1.m_start_vertex = start_vertex;
+		edge2.m_vertex = vertex;
+		edge2.m_start_vertex = start_vertex;
+
+	}
+
+	void OutputMiddleVertex(OutputEdge &edge, VertexType vertex, bool is_left) {
+		assert(edge.m_start_vertex != nullptr);
+
+		// add edge (same direction as OutputPolicy_Simple)
+		if(is_left) {
+			AddEdge(vertex, edge.m_vertex);
+		} else {
+			AddEdge(edge.m_vertex, vertex);
+		}
+
+		// update edge
+		edge.m_vertex = vertex;
+
+	}
+
+	void OutputStopVertex(OutputEdge &edge1, OutputEdge &edge2, VertexType vertex, bool is_merge, OutputEdge *edge_prev, OutputEdge *edge_next) {
+		POLYMATH_UNUSED(edge_prev);
+		POLYMATH_UNUSED(edge_next);
+		assert(edge1.m_start_vertex != nullptr);
+		assert(edge2.m_start_vertex != nullptr);
+
+		// add edges (same direction as OutputPolicy_Simple)
+		if(is_merge) {
+			AddEdge(edge1.m_vertex, vertex);
+			AddEdge(vertex, edge2.m_vertex);
+		} else {
+			AddEdge(edge2.m_vertex, vertex);
+			AddEdge(vertex, edge1.m_vertex);
+		}
+
+		// Join the loops. If both edges already belong to the same loop, the loop is now closed. This happens at the
+		// last vertex of the loop, which is a merge for holes and a regular stop vertex for outer loops.
+		StartVertex *root1 = FindStartVertexRoot(edge1.m_start_vertex);
+		StartVertex *root2 = FindStartVertexRoot(edge2.m_start_vertex);
+		if(root1 == root2) {
+			if(is_merge) {
+				++m_hole_loop_count;
+			} else {
+				++m_outer_loop_count;
+			}
+		} else {
+			if(root1->m_size < root2->m_size)
+				std::swap(root1, root2);
+			root2->m_parent = root1;
+			root1->m_size += root2->m_size;
+		}
+
+	}
+
+	void Visualize(Visualization<T> &vis) {
+		POLYMATH_UNUSED(vis);
+		// no output edges are stored
+	}
+
+	// Returns the total signed area of the output (outer loops count as positive, holes as negative).
+	double GetArea() const {
+		return -0.5 * m_area.ToDouble();
+	}
+
+	// Returns the total length of all output loops.
+	double GetPerimeter() const {
+		return m_perimeter;
+	}
+
+	// Returns the centroid of the output. The result is undefined if the area is zero.
+	Vertex<double> GetCentroid() const {
+		double area = m_area.ToDouble();
+		return Vertex<double>(m_moment_x.ToDouble() / (3.0 * area), m_moment_y.ToDouble() / (3.0 * area));
+	}
+
+	size_t GetLoopCount() const {
+		return m_outer_loop_count + m_hole_loop_count;
+	}
+
+	size_t GetOuterLoopCount() const {
+		return m_outer_loop_count;
+	}
+
+	size_t GetHoleLoopCount() const {
+		return m_hole_loop_count;
+	}
+
+	// Returns the exact accumulated area and moments of area. These are scaled by -2 and -6 respectively,
+	// because the output loops are clockwise.
+	const AccumulatorType& GetAreaAccumulator() const {
+		return m_area;
+	}
+	const AccumulatorType& GetMomentXAccumulator() const {
+		return m_moment_x;
+	}
+	const AccumulatorType& GetMomentYAccumulator() const {
+		return m_moment_y;
+	}
+
+};
+
+// Doesn't produce any output, it only records whether the output is non-empty. This is meant to be used with
+// SweepEngine::ProcessUntil, so the sweep can stop as soon as the first output vertex is found.
+template<typename T>
+class OutputPolicy_Detect {
+
+public:
+	typedef T ValueType;
+	typedef Vertex<T> VertexType;
+
+public:
+	struct OutputEdge {
+		bool m_active;
+	};
+
+public:
+	static constexpr bool START_NEEDS_PREV_NEXT = false;
+	static constexpr bool START_ALWAYS_NEEDS_PREV_NEXT = false;
+	static constexpr bool STOP_NEEDS_PREV_NEXT = false;
+
+private:
+	bool m_detected;
+
+public:
+	OutputPolicy_Detect() {
+		m_detected = false;
+	}
+
+	void Reset() {
+		m_detected = false;
+	}
+
+	static bool HasOutputEdge(OutputEdge &edge) {
+		return edge.m_active;
+	}
+
+	static void ClearOutputEdge(OutputEdge &edge) {
+		edge.m_active = false;
+	}
+
+	static void CopyOutputEdge(OutputEdge &from, OutputEdge &to) {
+		to.m_active = from.m_active;
+	}
+
+	static void SwapOutputEdges(OutputEdge &edge1, OutputEdge &edge2) {
+		std::swap(edge1.m_active, edge2.m_active);
+	}
+
+	void OutputStartVertex(OutputEdge &edge1, OutputEdge &edge2, VertexType vertex, bool is_split, OutputEdge *edge_prev, OutputEdge *edge_next) {
+		POLYMATH_UNUSED(vertex);
+		POLYMATH_UNUSED(is_split);
+		POLYMATH_UNUSED(edge_prev);
+		POLYMATH_UNUSED(edge_next);
+		edge1.m_active = true;
+		edge2.m_active = true;
+		m_detected = true;
+	}
+
+	void OutputMiddleVertex(OutputEdge &edge, VertexType vertex, bool is_left) {
+		POLYMATH_UNUSED(edge);
+		POLYMATH_UNUSED(vertex);
+		POLYMATH_UNUSED(is_left);
+	}
+
+	void OutputStopVertex(OutputEdge &edge1, OutputEdge &edge2, VertexType vertex, bool is_merge, OutputEdge *edge_prev, OutputEdge *edge_next) {
+		POLYMATH_UNUSED(edge1);
+		POLYMATH_UNUSED(edge2);
+		POLYMATH_UNUSED(vertex);
+		POLYMATH_UNUSED(is_merge);
+		POLYMATH_UNUSED(edge_prev);
+		POLYMATH_UNUSED(edge_next);
+	}
+
+	void Visualize(Visualization<T> &vis) {
+		POLYMATH_UNUSED(vis);
+		// no output edges are stored
+	}
+
+	// Returns whether any output vertex was generated since the last reset.
+	bool IsDetected() const {
+		return m_detected;
+	}
+
+};
+
+// Like OutputPolicy_Detect, but only records output regions with a non-zero area. Coincident edges can produce
+// zero-width regions (e.g. where two polygons share a horizontal edge), which OutputPolicy_Detect would report. Every
+// output region keeps the exact area of the edges that have been added so far, and regions are joined at stop vertices
+// like in OutputPolicy_Measure. When a loop is closed, the area of its region is complete, so the sweep can stop at the
+// rightmost vertex of the first region that isn't empty.
+template<typename T>
+class OutputPolicy_DetectArea {
+
+public:
+	typedef T ValueType;
+	typedef Vertex<T> VertexType;
+	typedef typename NumericalEngine<T>::AccumulatorType AccumulatorType;
+
+private:
+	struct Region {
+		size_t m_parent;
+		AccumulatorType m_area;
+	};
+
+public:
+	struct OutputEdge {
+		VertexType m_vertex;
+		size_t m_region;
+	};
+
+public:
+	static constexpr bool START_NEEDS_PREV_NEXT = false;
+	static constexpr bool START_ALWAYS_NEEDS_PREV_NEXT = false;
+	static constexpr bool STOP_NEEDS_PREV_NEXT = false;
+
+private:
+	std::vector<Region> m_regions;
+	bool m_detected;
+
+private:
+	size_t FindRegionRoot(size_t region) {
+		while(m_regions[region].m_parent != INDEX_NONE) {
+			size_t parent = m_regions[region].m_parent;
+			if(m_regions[parent].m_parent != INDEX_NONE)
+				m_regions[region].m_parent = m_regions[parent].m_parent;
+			region = parent;
+		}
+		return region;
+	}
+
+	void AddEdge(size_t region, VertexType a, VertexType b) {
+		NumericalEngine<T>::AccumulateArea(a.x, a.y, b.x, b.y, m_regions[region].m_area);
+	}
+
+public:
+	OutputPolicy_DetectArea() {
+		m_detected = false;
+	}
+
+	// Discards all output but keeps the allocated memory so it can be reused.
+	void Reset() {
+		m_regions.clear();
+		m_detected = false;
+	}
+
+	static bool HasOutputEdge(OutputEdge &edge) {
+		return (edge.m_region != INDEX_NONE);
+	}
+
+	static void ClearOutputEdge(OutputEdge &edge) {
+		edge.m_region = INDEX_NONE;
+	}
+
+	static void CopyOutputEdge(OutputEdge &from, OutputEdge &to) {
+		to.m_vertex = from.m_vertex;
+		to.m_region = from.m_region;
+	}
+
+	static void SwapOutputEdges(OutputEdge &edge1, OutputEdge &edge2) {
+		std::swap(edge1.m_vertex, edge2.m_vertex);
+		std::swap(edge1.m_region, edge2.m_region);
+	}
+
+	void OutputStartVertex(OutputEdge &edge1, OutputEdge &edge2, VertexType vertex, bool is_split, OutputEdge *edge_prev, OutputEdge *edge_next) {
+		POLYMATH_UNUSED(is_split);
+		POLYMATH_UNUSED(edge_prev);
+		POLYMATH_UNUSED(edge_next);
+
+		// create new region
+		size_t region = m_regions.size();
+		m_regions.push_back(Region{INDEX_NONE, AccumulatorType()});
+
+		// update edges
+		edge1.m_vertex = vertex;
+		edge1.m_region = region;
+		edge2.m_vertex = vertex;
+		edge2.m_region = region;
+
+	}
+
+	void OutputMiddleVertex(OutputEdge &edge, VertexType vertex, bool is_left) {
+		assert(edge.m_region != INDEX_NONE);
+
+		// add edge (same direction as OutputPolicy_Simple)
+		size_t region = FindRegionRoot(edge.m_region);
+		if(is_left) {
+			AddEdge(region, vertex, edge.m_vertex);
+		} else {
+			AddEdge(region, edge.m_vertex, vertex);
+		}
+
+		// update edge
+		edge.m_vertex = vertex;
+
+	}
+
+	void OutputStopVertex(OutputEdge &edge1, OutputEdge &edge2, VertexType vertex, bool is_merge, OutputEdge *edge_prev, OutputEdge *edge_next) {
+		POLYMATH_UNUSED(edge_prev);
+		POLYMATH_UNUSED(edge_next);
+		assert(edge1.m_region != INDEX_NONE);
+		assert(edge2.m_region != INDEX_NONE);
+
+		// add edges (same direction as OutputPolicy_Simple)
+		size_t root1 = FindRegionRoot(edge1.m_region);
+		size_t root2 = FindRegionRoot(edge2.m_region);
+		if(is_merge) {
+			AddEdge(root1, edge1.m_vertex, vertex);
+			AddEdge(root1, vertex, edge2.m_vertex);
+		} else {
+			AddEdge(root1, edge2.m_vertex, vertex);
+			AddEdge(root1, vertex, edge1.m_vertex);
+		}
+
+		// Join the regions. If both edges already belong to the same region, a loop is closed. Holes are always
+		// closed inside a region with a non-zero area, so any region that closes with a non-zero area is detected.
+		if(root1 == root2) {
+			if(!m_regions[root1].m_area.IsZero())
+				m_detected = true;
+		} else {
+			m_regions[root1].m_area.Add(m_regions[root2].m_area);
+			m_regions[root2].m_parent = root1;
+		}
+
+	}
+
+	void Visualize(Visualization<T> &vis) {
+		POLYMATH_UNUSED(vis);
+		// no output edges are stored
+	}
+
+	// Returns whether a region with a non-zero area was closed since the last reset.
+	bool IsDetected() const {
+		return m_detected;
+	}
+
+};
+
+enum RasterMode {
+	RASTERMODE_BINARY,
+	RASTERMODE_COVERAGE,
+};
+
+template<typename T>
+class OutputPolicy_Raster {
+
+public:
+	typedef T ValueType;
+	typedef Vertex<T> VertexType;
+
+public:
+	struct OutputEdge {
+		VertexType m_vertex;
+		bool m_active;
+	};
+
+public:
+	static constexpr bool START_NEEDS_PREV_NEXT = false;
+	static constexpr bool START_ALWAYS_NEEDS_PREV_NEXT = false;
+	static constexpr bool STOP_NEEDS_PREV_NEXT = false;
+
+private:
+	size_t m_width, m_height;
+	double m_offset_x, m_offset_y, m_scale_x, m_scale_y;
+	RasterMode m_mode;
+
+	// Each row contains the derivative of the coverage in the X direction, with one extra element for the right border.
+	std::vector<float> m_accumulation;
+
+private:
+	void AddEdge(VertexType a, VertexType b) {
+
+		// convert to pixel coordinates
+		double x0 = (double(a.x) - m_offset_x) * m_scale_x, y0 = (double(a.y) - m_offset_y) * m_scale_y;
+		double x1 = (double(b.x) - m_offset_x) * m_scale_x, y1 = (double(b.y) - m_offset_y) * m_scale_y;
+		if(y0 == y1)
+			return;
+
+		// Split the edge where it crosses the left and right border of the raster. The parts that are outside
+		// the raster can then be clamped to the border without changing the coverage inside the raster.
+		double w = double(m_width);
+		double split[2];
+		size_t splits = 0;
+		if((x0 < 0.0) != (x1 < 0.0))
+			split[splits++] = (0.0 - x0) / (x1 - x0);
+		if((x0 < w) != (x1 < w))
+			split[splits++] = (w - x0) / (x1 - x0);
+		if(splits == 2 && split[0] > split[1])
+			std::swap(split[0], split[1]);
+		double px = x0, py = y0;
+		for(size_t i = 0; i < splits; ++i) {
+			double qx = x0 + (x1 - x0) * split[i], qy = y0 + (y1 - y0) * split[i];
+			AddPixelEdge(std::min(std::max(px, 0.0), w), py, std::min(std::max(qx, 0.0), w), qy);
+			px = qx;
+			py = qy;
+		}
+		AddPixelEdge(std::min(std::max(px, 0.0), w), py, std::min(std::max(x1, 0.0), w), y1);
+
+	}
+
+	void AddPixelEdge(double x0, double y0, double x1, double y1) {
+		if(y0 == y1)
+			return;
+
+		// always go up, remember the direction
+		float dir = 1.0f;
+		if(y0 > y1) {
+			std::swap(x0, x1);
+			std::swap(y0, y1);
+			dir = -1.0f;
+		}
+
+		// clip to the raster
+		double h = double(m_height);
+		if(y1 <= 0.0 || y0 >= h)
+			return;
+		double dxdy = (x1 - x0) / (y1 - y0);
+		size_t row_begin = (y0 <= 0.0)? 0 : size_t(y0);
+		size_t row_end = (y1 >= h)? m_height : size_t(std::ceil(y1));
+
+		if(m_mode == RASTERMODE_BINARY) {
+
+			// sample at the pixel centers, the edge covers [y0, y1)
+			for(size_t row = row_begin; row < row_end; ++row) {
+				double yc = double(row) + 0.5;
+				if(yc < y0 || yc >= y1)
+					continue;
+				double xc = x0 + (yc - y0) * dxdy;
+				size_t col = size_t(std::min(std::max(std::floor(xc - 0.5) + 1.0, 0.0), double(m_width)));
+				m_accumulation[row * (m_width + 1) + col] += dir;
+			}
+
+		} else {
+
+			// calculate the exact area covered in each pixel of each row
+			for(size_t row = row_begin; row < row_end; ++row) {
+				float *line = m_accumulation.data() + row * (m_width + 1);
+				double ya = std::max(double(row), y0), yb = std::min(double(row + 1), y1);
+				double xa = x0 + (ya - y0) * dxdy, xb = x0 + (yb - y0) * dxdy;
+				float d = float(yb - ya) * dir;
+				double xl = std::min(xa, xb), xr = std::max(xa, xb);
+				double xl_floor = std::floor(xl), xr_ceil = std::ceil(xr);
+				size_t il = size_t(xl_floor), ir = size_t(xr_ceil);
+				if(ir <= il + 1) {
+
+					// the edge stays within one pixel
+					float xm = float(0.5 * (xl + xr) - xl_floor);
+					line[il] += d * (1.0f - xm);
+					if(il + 1 <= m_width)
+						line[il + 1] += d * xm;
+
+				} else {
+
+					// the edge crosses multiple pixels, the covered area grows linearly between the first and last pixel
+					float s = float(1.0 / (xr - xl));
+					float fl = float(xl - xl_floor), fr = float(xr - xr_ceil + 1.0);
+					float a_first = 0.5f * s * Square(1.0f - fl);
+					float a_last = 0.5f * s * Square(fr);
+					line[il] += d * a_first;
+					if(ir == il + 2) {
+						line[il + 1] += d * (1.0f - a_first - a_last);
+					} else {
+						float a1 = s * (1.5f - fl);
+						line[il + 1] += d * (a1 - a_first);
+						for(size_t i = il + 2; i < ir - 1; ++i) {
+							line[i] += d * s;
+						}
+						float a2 = a1 + float(ir - il - 3) * s;
+						line[ir - 1] += d * (1.0f - a2 - a_last);
+					}
+					if(ir <= m_width)
+						line[ir] += d * a_last;
+
+				}
+			}
+
+		}
+
+	}
+
+public:
+	// The raster has the given size and covers the rectangle (x_min, y_min) - (x_max, y_max). Row 0 corresponds to y_min.
+	OutputPolicy_Raster(size_t width, size_t height, double x_min, double y_min, double x_max, double y_max, RasterMode mode = RASTERMODE_COVERAGE) {
+		assert(width != 0 && height != 0);
+		assert(x_max > x_min && y_max > y_min);
+		m_width = width;
+		m_height = height;
+		m_offset_x = x_min;
+		m_offset_y = y_min;
+		m_scale_x = double(width) / (x_max - x_min);
+		m_scale_y = double(height) / (y_max - y_min);
+		m_mode = mode;
+		m_accumulation.resize((m_width + 1) * m_height, 0.0f);
+	}
+
+	// Discards all output but keeps the allocated memory so it can be reused.
+	void Reset() {
+		std::fill(m_accumulation.begin(), m_accumulation.end(), 0.0f);
+	}
+
+	static bool HasOutputEdge(OutputEdge &edge) {
+		return edge.m_active;
+	}
+
+	static void ClearOutputEdge(OutputEdge &edge) {
+		edge.m_active = false;
+	}
+
+	static void CopyOutputEdge(OutputEdge &from, OutputEdge &to) {
+		to.m_vertex = from.m_vertex;
+		to.m_active = from.m_active;
+	}
+
+	static void SwapOutputEdges(OutputEdge &edge1, OutputEdge &edge2) {
+		std::swap(edge1.m_vertex, edge2.m_vertex);
+		std::swap(edge1.m_active, edge2.m_active);
+	}
+
+	void OutputStartVertex(OutputEdge &edge1, OutputEdge &edge2, VertexType vertex, bool is_split, OutputEdge *edge_prev, OutputEdge *edge_next) {
+		POLYMATH_UNUSED(is_split);
+		POLYMATH_UNUSED(edge_prev);
+		POLYMATH_UNUSED(edge_next);
+
+		// update edges
+		edge1.m_vertex = vertex;
+		edge1.m_active = true;
+		edge2.m_vertex = vertex;
+		edge2.m_active = true;
+
+	}
+
+	void OutputMiddleVertex(OutputEdge &edge, VertexType vertex, bool is_left) {
+		assert(edge.m_active);
+
+		// add edge (same direction as OutputPolicy_Simple)
+		if(is_left) {
+			AddEdge(vertex, edge.m_vertex);
+		} else {
+			AddEdge(edge.m_vertex, vertex);
+		}
+
+		// update edge
+		edge.m_vertex = vertex;
+
+	}
+
+	void OutputStopVertex(OutputEdge &edge1, OutputEdge &edge2, VertexType vertex, bool is_merge, OutputEdge *edge_prev, OutputEdge *edge_next) {
+		POLYMATH_UNUSED(edge_prev);
+		POLYMATH_UNUSED(edge_next);
+		assert(edge1.m_active);
+		assert(edge2.m_active);
+
+		// add edges (same direction as OutputPolicy_Simple)
+		if(is_merge) {
+			AddEdge(edge1.m_vertex, vertex);
+			AddEdge(vertex, edge2.m_vertex);
+		} else {
+			AddEdge(edge2.m_vertex, vertex);
+			AddEdge(vertex, edge1.m_vertex);
+		}
+
+	}
+
+	void Visualize(Visualization<T> &vis) {
+		POLYMATH_UNUSED(vis);
+		// no output edges are stored
+	}
+
+	size_t GetWidth() const {
+		return m_width;
+	}
+
+	size_t GetHeight() const {
+		return m_height;
+	}
+
+	// Returns the coverage of every pixel (row-major, between 0 and 1). In binary mode the coverage is either 0 or 1.
+	std::vector<float> ResultRaster() {
+		std::vector<float> raster;
+		ResultRasterInto(raster);
+		return raster;
+	}
+
+	// Same as ResultRaster(), but reuses the memory of an existing vector.
+	void ResultRasterInto(std::vector<float> &raster) {
+		raster.resize(m_width * m_height);
+		for(size_t row = 0; row < m_height; ++row) {
+			const float *line = m_accumulation.data() + row * (m_width + 1);
+			float *out = raster.data() + row * m_width;
+			float sum = 0.0f;
+			if(m_mode == RASTERMODE_BINARY) {
+				for(size_t col = 0; col < m_width; ++col) {
+					sum += line[col];
+					out[col] = (sum != 0.0f)? 1.0f : 0.0f;
+				}
+			} else {
+				for(size_t col = 0; col < m_width; ++col) {
+					sum += line[col];
+					out[col] = std::min(std::fabs(sum), 1.0f);
+				}
+			}
+		}
+	}
+
+};
+
+// Forwards all output to two other output policies, so multiple results can be generated from a single sweep.
+// Policies can be nested to get more than two outputs.
+template<class OutputPolicy1, class OutputPolicy2>
+class OutputPolicy_Tee {
+
+	static_assert(std::is_same<typename OutputPolicy1::ValueType, typename OutputPolicy2::ValueType>::value, "Output policies must use the same value type.");
+
+public:
+	typedef typename OutputPolicy1::ValueType ValueType;
+	typedef typename OutputPolicy1::VertexType VertexType;
+
+public:
+	struct OutputEdge {
+		typename OutputPolicy1::OutputEdge m_output_edge1;
+		typename OutputPolicy2::OutputEdge m_output_edge2;
+	};
+
+public:
+	static constexpr bool START_NEEDS_PREV_NEXT = OutputPolicy1::START_NEEDS_PREV_NEXT || OutputPolicy2::START_NEEDS_PREV_NEXT;
+	static constexpr bool START_ALWAYS_NEEDS_PREV_NEXT = OutputPolicy1::START_ALWAYS_NEEDS_PREV_NEXT || OutputPolicy2::START_ALWAYS_NEEDS_PREV_NEXT;
+	static constexpr bool STOP_NEEDS_PREV_NEXT = OutputPolicy1::STOP_NEEDS_PREV_NEXT || OutputPolicy2::STOP_NEEDS_PREV_NEXT;
+
+private:
+	OutputPolicy1 m_output_policy1;
+	OutputPolicy2 m_output_policy2;
+
+public:
+	OutputPolicy_Tee(OutputPolicy1 output_policy1 = OutputPolicy1(), OutputPolicy2 output_policy2 = OutputPolicy2())
+		: m_output_policy1(std::move(output_policy1)), m_output_policy2(std::move(output_policy2)) {}
+
+	OutputPolicy1& GetOutputPolicy1() { return m_output_policy1; }
+	OutputPolicy2& GetOutputPolicy2() { return m_output_policy2; }
+
+	void Reset() {
+		m_output_policy1.Reset();
+		m_output_policy2.Reset();
+	}
+
+	// both policies have output edges in the same places, so checking one is enough
+	static bool HasOutputEdge(OutputEdge &edge) {
+		return OutputPolicy1::HasOutputEdge(edge.m_output_edge1);
+	}
+
+	static void ClearOutputEdge(OutputEdge &edge) {
+		OutputPolicy1::ClearOutputEdge(edge.m_output_edge1);
+		OutputPolicy2::ClearOutputEdge(edge.m_output_edge2);
+	}
+
+	static void CopyOutputEdge(OutputEdge &from, OutputEdge &to) {
+		OutputPolicy1::CopyOutputEdge(from.m_output_edge1, to.m_output_edge1);
+		OutputPolicy2::CopyOutputEdge(from.m_output_edge2, to.m_output_edge2);
+	}
+
+	static void SwapOutputEdges(OutputEdge &edge1, OutputEdge &edge2) {
+		OutputPolicy1::SwapOutputEdges(edge1.m_output_edge1, edge2.m_output_edge1);
+		OutputPolicy2::SwapOutputEdges(edge1.m_output_edge2, edge2.m_output_edge2);
+	}
+
+	void OutputStartVertex(OutputEdge &edge1, OutputEdge &edge2, VertexType vertex, bool is_split, OutputEdge *edge_prev, OutputEdge *edge_next) {
+		typename OutputPolicy1::OutputEdge *edge_prev1 = (edge_prev == nullptr)? nullptr : &edge_prev->m_output_edge1;
+		typename OutputPolicy1::OutputEdge *edge_next1 = (edge_next == nullptr)? nullptr : &edge_next->m_output_edge1;
+		typename OutputPolicy2::OutputEdge *edge_prev2 = (edge_prev == nullptr)? nullptr : &edge_prev->m_output_edge2;
+		typename OutputPolicy2::OutputEdge *edge_next2 = (edge_next == nullptr)? nullptr : &edge_next->m_output_edge2;
+		m_output_policy1.OutputStartVertex(edge1.m_output_edge1, edge2.m_output_edge1, vertex, is_split, edge_prev1, edge_next1);
+		m_output_policy2.OutputStartVertex(edge1.m_output_edge2, edge2.m_output_edge2, vertex, is_split, edge_prev2, edge_next2);
+	}
+
+	void OutputMiddleVertex(OutputEdge &edge, VertexType vertex, bool is_left) {
+		m_output_policy1.OutputMiddleVertex(edge.m_output_edge1, vertex, is_left);
+		m_output_policy2.OutputMiddleVertex(edge.m_output_edge2, vertex, is_left);
+	}
+
+	void OutputStopVertex(OutputEdge &edge1, OutputEdge &edge2, VertexType vertex, bool is_merge, OutputEdge *edge_prev, OutputEdge *edge_next) {
+		typename OutputPolicy1::OutputEdge *edge_prev1 = (edge_prev == nullptr)? nullptr : &edge_prev->m_output_edge1;
+		typename OutputPolicy1::OutputEdge *edge_next1 = (edge_next == nullptr)? nullptr : &edge_next->m_output_edge1;
+		typename OutputPolicy2::OutputEdge *edge_prev2 = (edge_prev == nullptr)? nullptr : &edge_prev->m_output_edge2;
+		typename OutputPolicy2::OutputEdge *edge_next2 = (edge_next == nullptr)? nullptr : &edge_next->m_output_edge2;
+		m_output_policy1.OutputStopVertex(edge1.m_output_edge1, edge2.m_output_edge1, vertex, is_merge, edge_prev1, edge_next1);
+		m_output_policy2.OutputStopVertex(edge1.m_output_edge2, edge2.m_output_edge2, vertex, is_merge, edge_prev2, edge_next2);
+	}
+
+	void Visualize(Visualization<ValueType> &vis) {
+		m_output_policy1.Visualize(vis);
+		m_output_policy2.Visualize(vis);
+	}
+
+	// the result of the first policy, use GetOutputPolicy2() to get the other one
+	template<typename W>
+	Polygon<ValueType, W> Result() {
+		return m_output_policy1.template Result<W>();
+	}
+
+	template<typename W>
+	void ResultInto(Polygon<ValueType, W> &result) {
+		m_output_policy1.template ResultInto<W>(result);
+	}
+
 };
 
 }
@@ -2,9 +2,23 @@
 
 #include "Common.h"
 
+#include "HalfEdgeMesh.h"
 #include "OutputPolicy.h"
 #include "Polygon.h"
+#include "PolygonBitmap.h"
+#include "PolygonClearance.h"
+#include "PolygonConvexHull.h"
+#include "PolygonCurves.h"
+#include "PolygonHatch.h"
+#include "PolygonMinkowski.h"
+#include "PolygonOffset.h"
+#include "PolygonOverlap.h"
 #include "PolygonPoint.h"
+#include "PolygonReduce.h"
+#include "PolygonValidate.h"
+#include "Polyline.h"
+#include "PolylineStroke.h"
+#include "SegmentIntersections.h"
 #include "SweepEngine.h"
 #include "Vertex.h"
 #include "Visualization.h"
@@ -47,4 +61,14 @@ Polygon<T> PolygonSimplify_Negative(const Polygon<T, W> &polygon) {
 	return engine.Result();
 }
 
+// Returns the pieces of the polyline that are inside (or outside) the polygon. Pieces that lie on the boundary of the
+// polygon count as inside. The polygon output isn't needed, so the sweep uses OutputPolicy_Detect which doesn't store
+// anything.
+template<typename T, typename W = default_winding_t>
+Polyline<T> PolylineClip_NonZero(const Polyline<T> &polyline, const Polygon<T, W> &polygon, bool inside = true) {
+	SweepEngine<T, OutputPolicy_Detect<T>, WindingPolicy_NonZero<W>> engine(polygon, polyline);
+	engine.Process();
+	return engine.PathResult(inside);
+}
+
 }
@@ -0,0 +1,193 @@
+#pragma once
+
+#include "Common.h"
+
+#include "Polygon.h"
+#include "Vertex.h"
+
+namespace PolyMath {
+
+// A horizontal run of filled pixels in row y, from x1 to x2 (exclusive). Pixel (x, y) is the unit square from (x, y)
+// to (x + 1, y + 1).
+template<typename T>
+struct BitmapRun {
+	T y, x1, x2;
+};
+
+// Temporary memory used by BitmapTraceLoops, so it can be reused for many masks.
+template<typename T>
+struct BitmapTraceBuffers {
+	struct Edge {
+		Vertex<T> a, b;
+		size_t next;
+	};
+	std::vector<BitmapRun<T>> runs;
+	std::vector<Edge> edges;
+	std::vector<size_t> order;
+	std::vector<uint8_t> visited;
+};
+
+// Traces the contours of a set of runs directly and adds them to the sink, without a sweep. The runs may be in any
+// order and may overlap. The boundary consists of the vertical sides of the runs and the horizontal edges where the
+// coverage of two adjacent rows differs, which are linked into loops by sorting them by their first vertex. Every edge
+// has the filled side on its right, so outer loops are clockwise and holes are counterclockwise, like the output of
+// OutputPolicy_Simple. Pixels that only touch at a corner are not connected: the loop always turns towards its own
+// pixel. Only the corners are added, so a mask with a few large shapes produces a few small loops regardless of the
+// number of pixels. The cost is O(r log r) for r runs.
+template<typename Sink, typename T>
+void BitmapTraceLoops(Sink &sink, const BitmapRun<T> *runs, size_t n, typename Sink::WindingWeightType winding_weight, BitmapTraceBuffers<T> &buffers) {
+	typedef typename BitmapTraceBuffers<T>::Edge Edge;
+
+	// sort the runs and merge runs that overlap or touch
+	buffers.runs.clear();
+	for(size_t i = 0; i < n; ++i) {
+		if(runs[i].x1 < runs[i].x2)
+			buffers.runs.push_back(runs[i]);
+	}
+	std::sort(buffers.runs.begin(), buffers.runs.end(), [](const BitmapRun<T> &a, const BitmapRun<T> &b) {
+		return (a.y < b.y || (a.y == b.y && a.x1 < b.x1));
+	});
+	size_t run_count = 0;
+	for(const BitmapRun<T> &run : buffers.runs) {
+		if(run_count != 0 && buffers.runs[run_count - 1].y == run.y && buffers.runs[run_count - 1].x2 >= run.x1) {
+			buffers.runs[run_count - 1].x2 = std::max(buffers.runs[run_count - 1].x2, run.x2);
+		} else {
+			buffers.runs[run_count++] = run;
+		}
+	}
+	buffers.runs.resize(run_count);
+
+	// horizontal edges between the rows below and above line y
+	buffers.edges.clear();
+	auto AddHorizontalEdges = [&](T y, const BitmapRun<T> *below, const BitmapRun<T> *below_end, const BitmapRun<T> *above, const BitmapRun<T> *above_end) {
+		bool in_below = false, in_above = false;
+		T x = 0;
+		while(below != below_end || above != above_end) {
+			T x_below = (below == below_end)? std::numeric_limits<T>::max() : (in_below)? below->x2 : below->x1;
+			T x_above = (above == above_end)? std::numeric_limits<T>::max() : (in_above)? above->x2 : above->x1;
+			T x_next = std::min(x_below, x_above);
+			if(in_below != in_above && x < x_next) {
+				if(in_above) {
+					buffers.edges.push_back(Edge{Vertex<T>(x_next, y), Vertex<T>(x, y), INDEX_NONE});
+				} else {
+					buffers.edges.push_back(Edge{Vertex<T>(x, y), Vertex<T>(x_next, y), INDEX_NONE});
+				}
+			}
+			if(x_below == x_next) {
+				if(in_below)
+					++below;
+				in_below = !in_below;
+			}
+			if(x_above == x_next) {
+				if(in_above)
+					++above;
+				in_above = !in_above;
+			}
+			x = x_next;
+		}
+	};
+	const BitmapRun<T> *row_data = buffers.runs.data();
+	for(size_t i = 0; i < run_count; ) {
+		T y = buffers.runs[i].y;
+		size_t j = i;
+		while(j < run_count && buffers.runs[j].y == y) {
+			++j;
+		}
+		size_t k = j;
+		while(k < run_count && buffers.runs[k].y == y + 1) {
+			++k;
+		}
+		if(i == 0 || buffers.runs[i - 1].y != y - 1)
+			AddHorizontalEdges(y, nullptr, nullptr, row_data + i, row_data + j);
+		AddHorizontalEdges(y + 1, row_data + i, row_data + j, row_data + j, row_data + k);
+		i = j;
+	}
+
+	// vertical edges at both ends of every run
+	for(const BitmapRun<T> &run : buffers.runs) {
+		buffers.edges.push_back(Edge{Vertex<T>(run.x1, run.y), Vertex<T>(run.x1, run.y + 1), INDEX_NONE});
+		buffers.edges.push_back(Edge{Vertex<T>(run.x2, run.y + 1), Vertex<T>(run.x2, run.y), INDEX_NONE});
+	}
+
+	// link every edge to the edge that starts at its end (if there are two, take the one that turns right)
+	auto VertexLess = [](Vertex<T> a, Vertex<T> b) {
+		return (a.y < b.y || (a.y == b.y && a.x < b.x));
+	};
+	buffers.order.resize(buffers.edges.size());
+	for(size_t i = 0; i < buffers.edges.size(); ++i) {
+		buffers.order[i] = i;
+	}
+	std::sort(buffers.order.begin(), buffers.order.end(), [&](size_t a, size_t b) {
+		return VertexLess(buffers.edges[a].a, buffers.edges[b].a);
+	});
+	for(Edge &edge : buffers.edges) {
+		auto it = std::lower_bound(buffers.order.begin(), buffers.order.end(), edge.b, [&](size_t a, Vertex<T> v) {
+			return VertexLess(buffers.edges[a].a, v);
+		});
+		assert(it != buffers.order.end() && !VertexLess(edge.b, buffers.edges[*it].a));
+		edge.next = *it;
+		if(it + 1 != buffers.order.end() && !VertexLess(edge.b, buffers.edges[*(it + 1)].a)) {
+			const Edge &other = buffers.edges[*(it + 1)];
+			bool right = (edge.b.x - edge.a.x > 0)? (other.b.y < other.a.y) : (edge.b.x - edge.a.x < 0)? (other.b.y > other.a.y) :
+					(edge.b.y - edge.a.y > 0)? (other.b.x > other.a.x) : (other.b.x < other.a.x);
+			if(right)
+				edge.next = *(it + 1);
+		}
+	}
+
+	// trace the loops, only the vertices where the direction changes are added
+	auto SameDirection = [](const Edge &e1, const Edge &e2) {
+		return ((e1.a.x == e1.b.x) == (e2.a.x == e2.b.x) && (e1.a.x < e1.b.x) == (e2.a.x < e2.b.x) && (e1.a.y < e1.b.y) == (e2.a.y < e2.b.y));
+	};
+	buffers.visited.assign(buffers.edges.size(), 0);
+	for(size_t i = 0; i < buffers.edges.size(); ++i) {
+		if(buffers.visited[i])
+			continue;
+		size_t current = i;
+		do {
+			size_t next = buffers.edges[current].next;
+			buffers.visited[current] = 1;
+			if(!SameDirection(buffers.edges[current], buffers.edges[next]))
+				sink.AddVertex(buffers.edges[current].b);
+			current = next;
+		} while(current != i);
+		sink.AddLoopEnd(winding_weight);
+	}
+
+}
+
+// Converts a set of runs to a polygon, see BitmapTraceLoops.
+template<typename T>
+Polygon<T> PolygonFromRuns(const std::vector<BitmapRun<T>> &runs) {
+	Polygon<T> result;
+	BitmapTraceBuffers<T> buffers;
+	BitmapTraceLoops(result, runs.data(), runs.size(), 1, buffers);
+	return result;
+}
+
+// Converts a bitmap to a polygon, where every pixel that isn't zero is filled. The rows are 'stride' bytes apart. The
+// bitmap is converted to runs first, see BitmapTraceLoops.
+template<typename T>
+Polygon<T> PolygonFromBitmap(const uint8_t *data, size_t width, size_t height, size_t stride) {
+	std::vector<BitmapRun<T>> runs;
+	for(size_t y = 0; y < height; ++y) {
+		const uint8_t *row = data + y * stride;
+		for(size_t x = 0; x < width; ) {
+			if(row[x] == 0) {
+				++x;
+				continue;
+			}
+			size_t x1 = x;
+			while(x < width && row[x] != 0) {
+				++x;
+			}
+			runs.push_back(BitmapRun<T>{T(y), T(x1), T(x)});
+		}
+	}
+	Polygon<T> result;
+	BitmapTraceBuffers<T> buffers;
+	BitmapTraceLoops(result, runs.data(), runs.size(), 1, buffers);
+	return result;
+}
+
+}
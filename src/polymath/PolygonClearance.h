@@ -0,0 +1,174 @@
+#pragma once
+
+#include "Common.h"
+
+#include "Polygon.h"
+#include "PolygonPoint.h"
+#include "Vertex.h"
+
+#include <functional>
+#include <map>
+#include <queue>
+#include <tuple>
+
+namespace PolyMath {
+
+// A pair of loops that are closer than the required clearance. The points are the closest points on both loops.
+struct ClearanceViolation {
+	size_t loop1, loop2;
+	double distance;
+	Vertex<double> point1, point2;
+};
+
+// Finds all pairs of labeled segments that are closer than 'clearance' with a window sweep. The segments are sorted
+// by their left end, and the active set contains all segments that end less than 'clearance' to the left of the
+// sweep position, ordered by their lowest Y coordinate. Long segments are split into pieces for this purpose, so every
+// active piece has a bounded height and only the pieces that can be within the clearance in the Y direction are
+// visited. The closest pair of each pair of labels is returned.
+class ClearanceSweep {
+
+private:
+	struct Segment {
+		Vertex<double> m_a, m_b;
+		size_t m_label;
+	};
+
+	struct Piece {
+		size_t m_segment;
+		double m_x1, m_x2, m_y1, m_y2;
+	};
+
+private:
+	std::vector<Segment> m_segments;
+	std::vector<Piece> m_pieces;
+	std::vector<ClearanceViolation> m_candidates;
+
+public:
+	void AddSegment(Vertex<double> a, Vertex<double> b, size_t label) {
+		m_segments.push_back(Segment{a, b, label});
+	}
+
+	template<typename Filter>
+	std::vector<ClearanceViolation> Run(double clearance, Filter &&filter) {
+
+		// split the segments into pieces that are at most as large as the clearance or the average segment length
+		double total_length = 0.0;
+		for(const Segment &segment : m_segments) {
+			total_length += std::hypot(segment.m_b.x - segment.m_a.x, segment.m_b.y - segment.m_a.y);
+		}
+		double piece_size = std::max(clearance, total_length / double(std::max<size_t>(m_segments.size(), 1)));
+		m_pieces.clear();
+		for(size_t i = 0; i < m_segments.size(); ++i) {
+			Vertex<double> a = m_segments[i].m_a, b = m_segments[i].m_b;
+			double extent = std::max(std::fabs(b.x - a.x), std::fabs(b.y - a.y));
+			size_t steps = (piece_size > 0.0)? std::max<size_t>(1, size_t(std::ceil(extent / piece_size))) : 1;
+			for(size_t j = 0; j < steps; ++j) {
+				double t1 = double(j) / double(steps), t2 = double(j + 1) / double(steps);
+				Vertex<double> p1(a.x + (b.x - a.x) * t1, a.y + (b.y - a.y) * t1), p2(a.x + (b.x - a.x) * t2, a.y + (b.y - a.y) * t2);
+				m_pieces.push_back(Piece{i, std::min(p1.x, p2.x), std::max(p1.x, p2.x), std::min(p1.y, p2.y), std::max(p1.y, p2.y)});
+			}
+		}
+		std::sort(m_pieces.begin(), m_pieces.end(), [](const Piece &a, const Piece &b) { return a.m_x1 < b.m_x1; });
+
+		// sweep
+		double max_height = 0.0;
+		std::multimap<double, size_t> active;
+		std::vector<std::multimap<double, size_t>::iterator> active_iterators(m_pieces.size());
+		std::priority_queue<std::pair<double, size_t>, std::vector<std::pair<double, size_t>>, std::greater<std::pair<double, size_t>>> expiry;
+		double clearance2 = clearance * clearance;
+		m_candidates.clear();
+		for(size_t i = 0; i < m_pieces.size(); ++i) {
+			const Piece &piece = m_pieces[i];
+			const Segment &segment = m_segments[piece.m_segment];
+
+			// remove pieces that are too far to the left
+			while(!expiry.empty() && expiry.top().first < piece.m_x1 - clearance) {
+				active.erase(active_iterators[expiry.top().second]);
+				expiry.pop();
+			}
+
+			// check pieces that are close enough in the Y direction
+			auto end = active.upper_bound(piece.m_y2 + clearance);
+			for(auto it = active.lower_bound(piece.m_y1 - clearance - max_height); it != end; ++it) {
+				const Piece &other = m_pieces[it->second];
+				const Segment &other_segment = m_segments[other.m_segment];
+				if(other.m_y2 < piece.m_y1 - clearance || other_segment.m_label == segment.m_label || !filter(other_segment.m_label, segment.m_label))
+					continue;
+				ClearanceViolation violation;
+				double dist2 = SegmentSegmentDistance2(other_segment.m_a, other_segment.m_b, segment.m_a, segment.m_b, violation.point1, violation.point2);
+				if(dist2 < clearance2) {
+					violation.loop1 = other_segment.m_label;
+					violation.loop2 = segment.m_label;
+					violation.distance = std::sqrt(dist2);
+					if(violation.loop1 > violation.loop2) {
+						std::swap(violation.loop1, violation.loop2);
+						std::swap(violation.point1, violation.point2);
+					}
+					m_candidates.push_back(violation);
+				}
+			}
+
+			// add the piece
+			active_iterators[i] = active.emplace(piece.m_y1, i);
+			expiry.emplace(piece.m_x2, i);
+			max_height = std::max(max_height, piece.m_y2 - piece.m_y1);
+
+		}
+
+		// keep the closest pair for each pair of labels
+		std::sort(m_candidates.begin(), m_candidates.end(), [](const ClearanceViolation &a, const ClearanceViolation &b) {
+			return std::make_tuple(a.loop1, a.loop2, a.distance) < std::make_tuple(b.loop1, b.loop2, b.distance);
+		});
+		std::vector<ClearanceViolation> result;
+		for(const ClearanceViolation &violation : m_candidates) {
+			if(result.empty() || result.back().loop1 != violation.loop1 || result.back().loop2 != violation.loop2)
+				result.push_back(violation);
+		}
+		return result;
+	}
+
+};
+
+template<typename T, typename W>
+void PolygonClearanceAddLoops(ClearanceSweep &sweep, const Polygon<T, W> &polygon, size_t label_offset) {
+	for(size_t i = 0; i < polygon.loops.size(); ++i) {
+		if(polygon.loops[i].weight == 0)
+			continue;
+		const Vertex<T> *vertices = polygon.GetLoopVertices(i);
+		size_t n = polygon.GetLoopVertexCount(i);
+		for(size_t j = 0; j < n; ++j) {
+			Vertex<T> a = vertices[j], b = vertices[(j == n - 1)? 0 : j + 1];
+			sweep.AddSegment(Vertex<double>(double(a.x), double(a.y)), Vertex<double>(double(b.x), double(b.y)), label_offset + i);
+		}
+	}
+}
+
+// Returns all pairs of loops whose boundaries are closer than 'clearance', with the distance and the closest points.
+// Every loop is treated as a separate polygon, like in PolygonOverlapPairs. Loops whose boundaries intersect are
+// reported with distance zero, but loops that are nested without touching are reported with the distance between
+// their boundaries, use PolygonOverlapPairs to find those. The cost is O(n log n) plus the number of close segment
+// pairs.
+template<typename T, typename W>
+std::vector<ClearanceViolation> PolygonClearance(const Polygon<T, W> &polygon, double clearance) {
+	ClearanceSweep sweep;
+	PolygonClearanceAddLoops(sweep, polygon, 0);
+	return sweep.Run(clearance, [](size_t, size_t) { return true; });
+}
+
+// Same as above, but only returns pairs with one loop of 'a' and one loop of 'b', as (loop of a, loop of b).
+template<typename T, typename W>
+std::vector<ClearanceViolation> PolygonClearance(const Polygon<T, W> &a, const Polygon<T, W> &b, double clearance) {
+	ClearanceSweep sweep;
+	size_t count = a.loops.size();
+	PolygonClearanceAddLoops(sweep, a, 0);
+	PolygonClearanceAddLoops(sweep, b, count);
+	std::vector<ClearanceViolation> result = sweep.Run(clearance, [count](size_t label1, size_t label2) {
+		return (label1 < count) != (label2 < count);
+	});
+	for(ClearanceViolation &violation : result) {
+		violation.loop2 -= count;
+	}
+	return result;
+}
+
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Common.h"
+
+#include "NumericalEngine.h"
+#include "Polygon.h"
+#include "Vertex.h"
+
+namespace PolyMath {
+
+// Calculates the convex hull of a set of points with Andrew's monotone chain algorithm, using the exact orientation
+// test of the numerical engine. The hull is returned as a clockwise loop (the same orientation as the output of the
+// sweep engine) without collinear vertices. If all points are collinear, the hull has less than three vertices.
+// Points that are strictly inside the quadrilateral formed by the extreme points in the X and Y direction can't be on
+// the hull, so they are discarded before sorting, which removes nearly all points for typical inputs. The hull of a
+// union is the hull of the hulls of its parts, so very large point sets can be split into ranges that are processed in
+// parallel, followed by a final call on the combined hull vertices.
+template<typename T>
+void ConvexHullInto(std::vector<Vertex<T>> &hull, const Vertex<T> *points, size_t n) {
+	typedef PolyMath::NumericalEngine<T> NumericalEngine;
+
+	hull.clear();
+	if(n == 0)
+		return;
+
+	// find the extreme points
+	Vertex<T> min_x = points[0], max_x = points[0], min_y = points[0], max_y = points[0];
+	for(size_t i = 1; i < n; ++i) {
+		Vertex<T> p = points[i];
+		if(p.x < min_x.x || (p.x == min_x.x && p.y < min_x.y))
+			min_x = p;
+		if(p.x > max_x.x || (p.x == max_x.x && p.y > max_x.y))
+			max_x = p;
+		if(p.y < min_y.y || (p.y == min_y.y && p.x > min_y.x))
+			min_y = p;
+		if(p.y > max_y.y || (p.y == max_y.y && p.x < max_y.x))
+			max_y = p;
+	}
+
+	// discard points inside the counterclockwise quadrilateral of the extreme points
+	auto Left = [](Vertex<T> a, Vertex<T> b, Vertex<T> c) {
+		return NumericalEngine::OrientationTest(a.x, a.y, b.x, b.y, c.x, c.y, true);
+	};
+	std::vector<Vertex<T>> candidates;
+	for(size_t i = 0; i < n; ++i) {
+		Vertex<T> p = points[i];
+		if(!Left(min_x, min_y, p) || !Left(min_y, max_x, p) || !Left(max_x, max_y, p) || !Left(max_y, min_x, p))
+			candidates.push_back(p);
+	}
+
+	// sort the candidates in the same order as the sweep engine
+	std::sort(candidates.begin(), candidates.end(), [](Vertex<T> a, Vertex<T> b) {
+		return (a.x < b.x || (a.x == b.x && a.y < b.y));
+	});
+
+	// build the lower and upper hull (counterclockwise), skipping duplicates and collinear points
+	hull.resize(2 * candidates.size());
+	size_t k = 0;
+	for(size_t i = 0; i < candidates.size(); ++i) {
+		while(k >= 2 && !Left(hull[k - 2], hull[k - 1], candidates[i])) {
+			--k;
+		}
+		if(k == 0 || hull[k - 1].x != candidates[i].x || hull[k - 1].y != candidates[i].y)
+			hull[k++] = candidates[i];
+	}
+	for(size_t i = candidates.size() - 1, lower = k + 1; i-- > 0; ) {
+		while(k >= lower && !Left(hull[k - 2], hull[k - 1], candidates[i])) {
+			--k;
+		}
+		hull[k++] = candidates[i];
+	}
+	hull.resize((k > 1)? k - 1 : k); // the last point is the first point again
+
+	std::reverse(hull.begin(), hull.end());
+}
+
+// Returns the convex hull of all vertices of a polygon as a single clockwise loop with weight 1. The result is empty
+// if all vertices are collinear.
+template<typename T, typename W>
+Polygon<T, W> PolygonConvexHull(const Polygon<T, W> &polygon) {
+	Polygon<T, W> result;
+	ConvexHullInto(result.vertices, polygon.vertices.data(), polygon.vertices.size());
+	if(result.vertices.size() < 3) {
+		result.vertices.clear();
+	} else {
+		result.AddLoopEnd(1);
+	}
+	return result;
+}
+
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Common.h"
+
+#include "Vertex.h"
+
+namespace PolyMath {
+
+// These functions flatten curves into line segments while they are being added to a polygon, a polyline or the
+// LoopSink of a sweep engine. The number of segments is chosen per curve such that the distance between the curve and
+// the segments is at most 'tolerance'. The tolerance is never smaller than the error of the vertex type itself,
+// since a finer approximation would only create redundant vertices. The start point of each curve is not added,
+// because it is normally the end of the previous segment.
+
+template<typename Sink>
+double FlattenTolerance(double tolerance, Vertex<double> a, Vertex<double> b) {
+	double magnitude = std::max(std::max(std::fabs(a.x), std::fabs(a.y)), std::max(std::fabs(b.x), std::fabs(b.y)));
+	return std::max(tolerance, ConversionError<typename Sink::ValueType>(magnitude));
+}
+
+// Adds a circular arc that starts at 'start' and turns around 'center' by 'angle' radians (counterclockwise if positive).
+template<typename Sink>
+void FlattenArc(Sink &sink, Vertex<double> start, Vertex<double> center, double angle, double tolerance) {
+	typedef typename Sink::ValueType T;
+
+	double dx = start.x - center.x, dy = start.y - center.y, radius = std::hypot(dx, dy);
+	tolerance = FlattenTolerance<Sink>(tolerance, start, Vertex<double>(std::fabs(center.x) + radius, std::fabs(center.y) + radius));
+	double step_angle = (tolerance < radius)? 2.0 * std::acos(1.0 - tolerance / radius) : 0.5 * M_PI;
+	size_t steps = std::max<size_t>(1, size_t(std::ceil(std::fabs(angle) / step_angle)));
+
+	for(size_t i = 1; i <= steps; ++i) {
+		double c = std::cos(angle * double(i) / double(steps)), s = std::sin(angle * double(i) / double(steps));
+		sink.AddVertex(Vertex<T>(ConvertFromDouble<T>(center.x + dx * c - dy * s), ConvertFromDouble<T>(center.y + dx * s + dy * c)));
+	}
+
+}
+
+// Adds a complete circle as a new counterclockwise loop.
+template<typename Sink>
+void FlattenCircle(Sink &sink, Vertex<double> center, double radius, double tolerance, typename Sink::WindingWeightType winding_weight) {
+	FlattenArc(sink, Vertex<double>(center.x + radius, center.y), center, 2.0 * M_PI, tolerance);
+	sink.AddLoopEnd(winding_weight);
+}
+
+// Adds a quadratic Bezier curve from p0 to p2 with control point p1.
+template<typename Sink>
+void FlattenQuadraticBezier(Sink &sink, Vertex<double> p0, Vertex<double> p1, Vertex<double> p2, double tolerance) {
+	typedef typename Sink::ValueType T;
+
+	// the error of a segment is at most |B''| / 8 times the square of the parameter step
+	tolerance = FlattenTolerance<Sink>(tolerance, p0, p2);
+	double dd = std::hypot(p0.x - 2.0 * p1.x + p2.x, p0.y - 2.0 * p1.y + p2.y);
+	size_t steps = std::max<size_t>(1, size_t(std::ceil(std::sqrt(dd / (4.0 * tolerance)))));
+
+	for(size_t i = 1; i <= steps; ++i) {
+		double t = double(i) / double(steps), u = 1.0 - t;
+		double a = u * u, b = 2.0 * u * t, c = t * t;
+		sink.AddVertex(Vertex<T>(ConvertFromDouble<T>(a * p0.x + b * p1.x + c * p2.x), ConvertFromDouble<T>(a * p0.y + b * p1.y + c * p2.y)));
+	}
+
+}
+
+// Adds a cubic Bezier curve from p0 to p3 with control points p1 and p2.
+template<typename Sink>
+void FlattenCubicBezier(Sink &sink, Vertex<double> p0, Vertex<double> p1, Vertex<double> p2, Vertex<double> p3, double tolerance) {
+	typedef typename Sink::ValueType T;
+
+	// same as above, |B''| is at most 6 times the largest second difference of the control points
+	tolerance = FlattenTolerance<Sink>(tolerance, p0, p3);
+	double dd1 = std::hypot(p0.x - 2.0 * p1.x + p2.x, p0.y - 2.0 * p1.y + p2.y);
+	double dd2 = std::hypot(p1.x - 2.0 * p2.x + p3.x, p1.y - 2.0 * p2.y + p3.y);
+	size_t steps = std::max<size_t>(1, size_t(std::ceil(std::sqrt(3.0 * std::max(dd1, dd2) / (4.0 * tolerance)))));
+
+	for(size_t i = 1; i <= steps; ++i) {
+		double t = double(i) / double(steps), u = 1.0 - t;
+		double a = u * u * u, b = 3.0 * u * u * t, c = 3.0 * u * t * t, d = t * t * t;
+		sink.AddVertex(Vertex<T>(ConvertFromDouble<T>(a * p0.x + b * p1.x + c * p2.x + d * p3.x), ConvertFromDouble<T>(a * p0.y + b * p1.y + c * p2.y + d * p3.y)));
+	}
+
+}
+
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Common.h"
+
+#include "OutputPolicy.h"
+#include "Polygon.h"
+#include "Polyline.h"
+#include "SweepEngine.h"
+#include "Vertex.h"
+#include "WindingPolicy.h"
+
+namespace PolyMath {
+
+// Returns the hatch (infill) lines of a polygon (non-zero winding rule) as a set of two-point paths. The lines run in
+// the direction 'angle' (in radians) and are placed at multiples of 'spacing' from the origin, so the hatch lines of
+// different polygons line up. The polygon is rotated such that the hatch lines are vertical, and the sweep engine
+// generates a trapezoidal decomposition of the inside. Every hatch line that crosses a trapezoid produces one inside
+// interval, so the cost is O(n log n) for the sweep plus O(m log m) to sort the m intervals, instead of testing every
+// line against every edge. The paths are ordered by line and then along the line direction. If zigzag is true, every
+// other line is reversed (including the order of its paths), which is the usual order for toolpaths. The rotation is
+// done in double precision, so the end points are rounded to the nearest coordinate for integer types.
+template<typename T, typename W = default_winding_t>
+Polyline<T> PolygonHatch(const Polygon<T, W> &polygon, double spacing, double angle, bool zigzag = false) {
+	assert(spacing > 0.0);
+
+	// rotated coordinates: x is the position across the hatch lines, y is the position along them
+	double dir_x = std::cos(angle), dir_y = std::sin(angle);
+
+	// decompose the rotated polygon into trapezoids
+	typedef SweepEngine<double, OutputPolicy_Trapezoids<double>, WindingPolicy_NonZero<W>> Engine;
+	Engine engine;
+	engine.ResetGenerated([&](typename Engine::LoopSink &sink) {
+		for(size_t i = 0; i < polygon.loops.size(); ++i) {
+			const Vertex<T> *vertices = polygon.GetLoopVertices(i);
+			size_t n = polygon.GetLoopVertexCount(i);
+			for(size_t j = 0; j < n; ++j) {
+				double x = double(vertices[j].x), y = double(vertices[j].y);
+				sink.AddVertex(Vertex<double>(x * dir_y - y * dir_x, x * dir_x + y * dir_y));
+			}
+			sink.AddLoopEnd(polygon.loops[i].weight);
+		}
+	});
+	engine.Process();
+	std::vector<typename OutputPolicy_Trapezoids<double>::Trapezoid> trapezoids = engine.GetOutputPolicy().ResultTrapezoids();
+
+	// intersect the trapezoids with the hatch lines (each X coordinate belongs to the trapezoid that starts there)
+	struct Interval {
+		int64_t line;
+		double y1, y2;
+	};
+	std::vector<Interval> intervals;
+	for(const auto &t : trapezoids) {
+		double width = t.x2 - t.x1;
+		for(int64_t line = int64_t(std::ceil(t.x1 / spacing)); double(line) * spacing < t.x2; ++line) {
+			double frac = (double(line) * spacing - t.x1) / width;
+			double y1 = t.y1_lower + (t.y2_lower - t.y1_lower) * frac, y2 = t.y1_upper + (t.y2_upper - t.y1_upper) * frac;
+			if(y2 > y1)
+				intervals.push_back(Interval{line, y1, y2});
+		}
+	}
+	std::sort(intervals.begin(), intervals.end(), [](const Interval &a, const Interval &b) {
+		return (a.line < b.line || (a.line == b.line && a.y1 < b.y1));
+	});
+
+	// merge intervals that touch (at split and merge vertices)
+	size_t merged = 0;
+	for(size_t i = 0; i < intervals.size(); ++i) {
+		if(merged != 0 && intervals[merged - 1].line == intervals[i].line && intervals[i].y1 <= intervals[merged - 1].y2) {
+			intervals[merged - 1].y2 = std::max(intervals[merged - 1].y2, intervals[i].y2);
+		} else {
+			intervals[merged++] = intervals[i];
+		}
+	}
+	intervals.resize(merged);
+
+	// convert them back (reversed lines are also traversed in reverse order)
+	Polyline<T> result;
+	auto Convert = [&](double x, double y) {
+		return Vertex<T>(ConvertFromDouble<T>(x * dir_y + y * dir_x), ConvertFromDouble<T>(y * dir_y - x * dir_x));
+	};
+	for(size_t i = 0; i < intervals.size(); ) {
+		size_t j = i;
+		while(j < intervals.size() && intervals[j].line == intervals[i].line) {
+			++j;
+		}
+		double x = double(intervals[i].line) * spacing;
+		if(zigzag && (intervals[i].line & 1)) {
+			for(size_t k = j; k != i; ) {
+				--k;
+				result.AddVertex(Convert(x, intervals[k].y2));
+				result.AddVertex(Convert(x, intervals[k].y1));
+				result.AddPathEnd();
+			}
+		} else {
+			for(size_t k = i; k != j; ++k) {
+				result.AddVertex(Convert(x, intervals[k].y1));
+				result.AddVertex(Convert(x, intervals[k].y2));
+				result.AddPathEnd();
+			}
+		}
+		i = j;
+	}
+	return result;
+
+}
+
+}
@@ -0,0 +1,210 @@
+#pragma once
+
+#include "Common.h"
+
+#include "OutputPolicy.h"
+#include "Polygon.h"
+#include "SweepEngine.h"
+#include "Vertex.h"
+#include "WindingPolicy.h"
+
+#include <algorithm>
+
+namespace PolyMath {
+
+// Generates the convolution cycle of a single loop with a convex kernel. The filled region must be on the left side of
+// the loop, and the kernel must be counterclockwise. At vertices that turn towards the filled region, the cycle goes
+// back to the kernel center instead of walking backwards along the kernel. This way the cycle is the sum of the
+// translated loop, one parallelogram per edge and one fan per convex vertex, so the winding number is positive exactly
+// in the Minkowski sum, even if the cycle intersects itself.
+template<typename Sink>
+void PolygonMinkowskiLoop(Sink &sink, const std::vector<Vertex<double>> &points, const std::vector<Vertex<double>> &kernel, Vertex<double> kernel_center, typename Sink::WindingWeightType winding_weight) {
+	typedef typename Sink::ValueType T;
+
+	size_t n = points.size(), m = kernel.size();
+	assert(n >= 3);
+	assert(m >= 3);
+
+	// returns whether the direction 'd' is in the normal cone of kernel vertex 'j'
+	auto InCone = [&](Vertex<double> d, size_t j) {
+		Vertex<double> k0 = kernel[(j == 0)? m - 1 : j - 1], k1 = kernel[j], k2 = kernel[(j == m - 1)? 0 : j + 1];
+		double cross1 = (k1.x - k0.x) * d.y - (k1.y - k0.y) * d.x;
+		double cross2 = d.x * (k2.y - k1.y) - d.y * (k2.x - k1.x);
+		return (cross1 >= 0.0 && cross2 > 0.0);
+	};
+	auto AddVertex = [&](Vertex<double> a, Vertex<double> b) {
+		sink.AddVertex(Vertex<T>(ConvertFromDouble<T>(a.x + b.x), ConvertFromDouble<T>(a.y + b.y)));
+	};
+
+	// Find the kernel vertex of the last edge. The normal cones of a convex kernel cover all directions, but rounding
+	// errors can leave small gaps between them. In that case the kernel vertex that is furthest to the right of the edge
+	// is used, which is the vertex whose normal cone should have contained the direction.
+	Vertex<double> d1(points[0].x - points[n - 1].x, points[0].y - points[n - 1].y);
+	size_t j = 0;
+	while(j < m && !InCone(d1, j)) {
+		++j;
+	}
+	if(j == m) {
+		j = 0;
+		for(size_t k = 1; k < m; ++k) {
+			if(kernel[k].x * d1.y - kernel[k].y * d1.x > kernel[j].x * d1.y - kernel[j].y * d1.x)
+				j = k;
+		}
+	}
+
+	for(size_t i = 0; i < n; ++i) {
+		Vertex<double> p = points[i], p2 = points[(i == n - 1)? 0 : i + 1];
+		Vertex<double> d2(p2.x - p.x, p2.y - p.y);
+		double cross = d1.x * d2.y - d1.y * d2.x, dot = d1.x * d2.x + d1.y * d2.y;
+		AddVertex(p, kernel[j]);
+		if(cross > 0.0 || (cross == 0.0 && dot < 0.0)) {
+
+			// convex vertex, walk forward along the kernel
+			for(size_t k = 0; k < m && !InCone(d2, j); ++k) {
+				j = (j == m - 1)? 0 : j + 1;
+				AddVertex(p, kernel[j]);
+			}
+
+		} else if(!InCone(d2, j)) {
+
+			// reflex vertex, go back to the kernel center
+			for(size_t k = 0; k < m && !InCone(d2, j); ++k) {
+				j = (j == 0)? m - 1 : j - 1;
+			}
+			AddVertex(p, kernel_center);
+			AddVertex(p, kernel[j]);
+
+		}
+		d1 = d2;
+	}
+
+	sink.AddLoopEnd(winding_weight);
+
+}
+
+// Calculates the Minkowski sum of a polygon and a kernel. Neither polygon should have overlapping loops, such as the
+// result of any other operation, and both orientations are accepted. Convex kernels (a single convex loop) are used
+// directly, other kernels are first decomposed into convex pieces. All convolution cycles are resolved with a single
+// sweep.
+template<typename T, typename W = default_winding_t>
+Polygon<T> PolygonMinkowskiSum(const Polygon<T, W> &polygon, const Polygon<T, W> &kernel) {
+
+	// returns the vertices of a loop without duplicates, in the right order
+	auto GetLoop = [](std::vector<Vertex<double>> &points, const Polygon<T, W> &poly, size_t loop, bool reverse) {
+		const Vertex<T> *vertices = poly.GetLoopVertices(loop);
+		size_t n = poly.GetLoopVertexCount(loop);
+		points.clear();
+		for(size_t j = 0; j < n; ++j) {
+			Vertex<T> v = vertices[(reverse)? n - 1 - j : j];
+			if(points.empty() || points.back().x != double(v.x) || points.back().y != double(v.y))
+				points.emplace_back(double(v.x), double(v.y));
+		}
+		while(points.size() > 1 && points.back().x == points.front().x && points.back().y == points.front().y) {
+			points.pop_back();
+		}
+	};
+	auto GetArea = [](const std::vector<Vertex<double>> &points) {
+		double area = 0.0;
+		for(size_t j = 0; j < points.size(); ++j) {
+			Vertex<double> a = points[j], b = points[(j == points.size() - 1)? 0 : j + 1];
+			area += a.x * b.y - a.y * b.x;
+		}
+		return area;
+	};
+	auto GetCenter = [](const std::vector<Vertex<double>> &points) {
+		Vertex<double> center(0.0, 0.0);
+		for(size_t j = 0; j < points.size(); ++j) {
+			center.x += points[j].x;
+			center.y += points[j].y;
+		}
+		return Vertex<double>(center.x / double(points.size()), center.y / double(points.size()));
+	};
+
+	// check whether the kernel is a single convex loop
+	std::vector<Vertex<double>> points;
+	bool convex = false;
+	size_t kernel_loops = 0;
+	for(size_t i = 0; i < kernel.loops.size(); ++i) {
+		if(kernel.loops[i].weight != 0 && kernel.GetLoopVertexCount(i) != 0)
+			++kernel_loops;
+	}
+	if(kernel_loops == 1) {
+		for(size_t i = 0; i < kernel.loops.size(); ++i) {
+			if(kernel.loops[i].weight != 0 && kernel.GetLoopVertexCount(i) != 0)
+				GetLoop(points, kernel, i, false);
+		}
+		if(points.size() >= 3) {
+			if(GetArea(points) < 0.0)
+				std::reverse(points.begin(), points.end());
+			double total_angle = 0.0;
+			convex = true;
+			for(size_t j = 0; j < points.size(); ++j) {
+				Vertex<double> a = points[(j == 0)? points.size() - 1 : j - 1], b = points[j], c = points[(j == points.size() - 1)? 0 : j + 1];
+				double cross = (b.x - a.x) * (c.y - b.y) - (b.y - a.y) * (c.x - b.x), dot = (b.x - a.x) * (c.x - b.x) + (b.y - a.y) * (c.y - b.y);
+				if(cross < 0.0) {
+					convex = false;
+					break;
+				}
+				total_angle += std::atan2(cross, dot);
+			}
+			if(total_angle > 3.0 * M_PI)
+				convex = false;
+		}
+	}
+
+	// get the convex pieces of the kernel
+	std::vector<Vertex<double>> pieces;
+	std::vector<size_t> piece_ends;
+	if(convex) {
+		pieces = points;
+		piece_ends.push_back(pieces.size());
+	} else {
+		SweepEngine<T, OutputPolicy_Convex<T>, WindingPolicy_NonZero<W>> engine(kernel);
+		engine.Process();
+		Polygon<T> convex_pieces = engine.Result();
+		for(size_t i = 0; i < convex_pieces.loops.size(); ++i) {
+			GetLoop(points, convex_pieces, i, false);
+			if(points.size() < 3)
+				continue;
+			double area = GetArea(points);
+			if(area == 0.0)
+				continue;
+			if(area < 0.0)
+				std::reverse(points.begin(), points.end());
+			pieces.insert(pieces.end(), points.begin(), points.end());
+			piece_ends.push_back(pieces.size());
+		}
+	}
+
+	// get the orientation of the polygon
+	double total_area = 0.0;
+	for(size_t i = 0; i < polygon.loops.size(); ++i) {
+		GetLoop(points, polygon, i, false);
+		total_area += GetArea(points) * double(polygon.loops[i].weight);
+	}
+
+	// generate the convolution cycles directly in the engine
+	typedef SweepEngine<T, OutputPolicy_Simple<T>, WindingPolicy_NonZero<W>> Engine;
+	Engine engine;
+	engine.ResetGenerated([&](typename Engine::LoopSink &sink) {
+		std::vector<Vertex<double>> kernel_points;
+		for(size_t i = 0; i < polygon.loops.size(); ++i) {
+			if(polygon.loops[i].weight == 0)
+				continue;
+			GetLoop(points, polygon, i, (total_area < 0.0) != (polygon.loops[i].weight < 0));
+			if(points.size() < 3)
+				continue;
+			for(size_t k = 0; k < piece_ends.size(); ++k) {
+				size_t begin = (k == 0)? 0 : piece_ends[k - 1];
+				kernel_points.assign(pieces.begin() + begin, pieces.begin() + piece_ends[k]);
+				PolygonMinkowskiLoop(sink, points, kernel_points, GetCenter(kernel_points), 1);
+			}
+		}
+	});
+
+	// resolve the cycles
+	engine.Process();
+	return engine.Result();
+}
+
+}
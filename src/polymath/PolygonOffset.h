@@ -0,0 +1,168 @@
+#pragma once
+
+#include "Common.h"
+
+#include "OutputPolicy.h"
+#include "Polygon.h"
+#include "SweepEngine.h"
+#include "Vertex.h"
+#include "WindingPolicy.h"
+
+namespace PolyMath {
+
+enum OffsetJoinType {
+	OFFSETJOIN_ROUND,
+	OFFSETJOIN_MITER,
+	OFFSETJOIN_SQUARE,
+};
+
+// Returns the maximum angle for each step of a round join.
+inline double PolygonOffsetStepAngle(double distance, double arc_tolerance) {
+	return (arc_tolerance < distance)? 2.0 * std::acos(1.0 - arc_tolerance / distance) : 0.5 * M_PI;
+}
+
+// Generates the offset curve around a single vertex 'p' with incoming edge direction 'd1' and outgoing edge direction
+// 'd2' (both normalized). The curve is on the right side of the edges at the given distance. If the edges turn away
+// from the offset side, a join is added, otherwise the curve goes back to the original vertex. The sink can be a
+// polygon or the LoopSink of a sweep engine.
+template<typename Sink>
+void PolygonOffsetJoin(Sink &sink, Vertex<double> p, Vertex<double> d1, Vertex<double> d2, double distance, OffsetJoinType join_type, double miter_limit, double arc_tolerance, double step_angle) {
+	typedef typename Sink::ValueType T;
+
+	Vertex<double> n1(d1.y, -d1.x), n2(d2.y, -d2.x);
+	double sin_a = d1.x * d2.y - d1.y * d2.x, cos_a = d1.x * d2.x + d1.y * d2.y;
+	Vertex<double> q1(p.x + n1.x * distance, p.y + n1.y * distance), q2(p.x + n2.x * distance, p.y + n2.y * distance);
+
+	// nearly straight, use a single vertex where both offset edges meet
+	if(cos_a > 0.0 && std::fabs(sin_a) * distance <= arc_tolerance) {
+		double scale = distance / (1.0 + cos_a);
+		sink.AddVertex(Vertex<T>(ConvertFromDouble<T>(p.x + (n1.x + n2.x) * scale), ConvertFromDouble<T>(p.y + (n1.y + n2.y) * scale)));
+		return;
+	}
+
+	// turning towards the offset side, go back to the original vertex
+	if(sin_a < 0.0) {
+		sink.AddVertex(Vertex<T>(ConvertFromDouble<T>(q1.x), ConvertFromDouble<T>(q1.y)));
+		sink.AddVertex(Vertex<T>(ConvertFromDouble<T>(p.x), ConvertFromDouble<T>(p.y)));
+		sink.AddVertex(Vertex<T>(ConvertFromDouble<T>(q2.x), ConvertFromDouble<T>(q2.y)));
+		return;
+	}
+
+	// use the miter join if the miter is not too long
+	if(join_type == OFFSETJOIN_MITER && 2.0 <= Square(miter_limit) * (1.0 + cos_a)) {
+		double scale = distance / (1.0 + cos_a);
+		sink.AddVertex(Vertex<T>(ConvertFromDouble<T>(p.x + (n1.x + n2.x) * scale), ConvertFromDouble<T>(p.y + (n1.y + n2.y) * scale)));
+		return;
+	}
+
+	// round join
+	if(join_type == OFFSETJOIN_ROUND) {
+		double angle = std::atan2(std::fabs(sin_a), cos_a); // sin_a may be -0.0 for a full reversal
+		size_t steps = std::max<size_t>(1, size_t(std::ceil(angle / step_angle)));
+		sink.AddVertex(Vertex<T>(ConvertFromDouble<T>(q1.x), ConvertFromDouble<T>(q1.y)));
+		for(size_t j = 1; j < steps; ++j) {
+			double c = std::cos(angle * double(j) / double(steps)), s = std::sin(angle * double(j) / double(steps));
+			sink.AddVertex(Vertex<T>(ConvertFromDouble<T>(p.x + (n1.x * c - n1.y * s) * distance), ConvertFromDouble<T>(p.y + (n1.x * s + n1.y * c) * distance)));
+		}
+		sink.AddVertex(Vertex<T>(ConvertFromDouble<T>(q2.x), ConvertFromDouble<T>(q2.y)));
+		return;
+	}
+
+	// Square join, also used when the miter is too long. The corner is cut off perpendicular to the bisector, at
+	// the offset distance from the original vertex. For a full reversal the bisector is the edge direction.
+	Vertex<double> b(n1.x + n2.x, n1.y + n2.y);
+	double b_len = std::hypot(b.x, b.y);
+	if(b_len < 1e-12) {
+		b = d1;
+	} else {
+		b = Vertex<double>(b.x / b_len, b.y / b_len);
+	}
+	double t1 = distance * (1.0 - (n1.x * b.x + n1.y * b.y)) / (d1.x * b.x + d1.y * b.y);
+	double t2 = distance * (1.0 - (n2.x * b.x + n2.y * b.y)) / (d2.x * b.x + d2.y * b.y);
+	sink.AddVertex(Vertex<T>(ConvertFromDouble<T>(q1.x + d1.x * t1), ConvertFromDouble<T>(q1.y + d1.y * t1)));
+	sink.AddVertex(Vertex<T>(ConvertFromDouble<T>(q2.x + d2.x * t2), ConvertFromDouble<T>(q2.y + d2.y * t2)));
+
+}
+
+// Generates the raw offset curve of a single loop. The filled region must be on the left side of the loop, and the
+// curve is moved to the right side by 'distance' (which must not be negative). The winding number of the resulting
+// curve is positive exactly in the offset region, even if it intersects itself.
+template<typename Sink>
+void PolygonOffsetLoop(Sink &sink, const std::vector<Vertex<double>> &points, double distance, OffsetJoinType join_type, double miter_limit, double arc_tolerance, typename Sink::WindingWeightType winding_weight) {
+
+	size_t n = points.size();
+	assert(n >= 3);
+
+	double step_angle = PolygonOffsetStepAngle(distance, arc_tolerance);
+	for(size_t i = 0; i < n; ++i) {
+		Vertex<double> p0 = points[(i == 0)? n - 1 : i - 1], p1 = points[i], p2 = points[(i == n - 1)? 0 : i + 1];
+		double len1 = std::hypot(p1.x - p0.x, p1.y - p0.y), len2 = std::hypot(p2.x - p1.x, p2.y - p1.y);
+		Vertex<double> d1((p1.x - p0.x) / len1, (p1.y - p0.y) / len1), d2((p2.x - p1.x) / len2, (p2.y - p1.y) / len2);
+		PolygonOffsetJoin(sink, p1, d1, d2, distance, join_type, miter_limit, arc_tolerance, step_angle);
+	}
+
+	sink.AddLoopEnd(winding_weight);
+
+}
+
+// Grows (positive distance) or shrinks (negative distance) a polygon. The polygon should not have overlapping loops,
+// such as the result of any other operation. Both orientations are accepted. The miter limit is relative to the
+// distance. The arc tolerance is the maximum deviation of round joins, zero selects 1/500 of the distance.
+template<typename T, typename W = default_winding_t>
+Polygon<T> PolygonOffset(const Polygon<T, W> &polygon, double distance, OffsetJoinType join_type = OFFSETJOIN_ROUND, double miter_limit = 2.0, double arc_tolerance = 0.0) {
+
+	double abs_distance = std::fabs(distance);
+	if(arc_tolerance <= 0.0)
+		arc_tolerance = abs_distance * 0.002;
+
+	// The offset curves of the loops are resolved with a single sweep using the positive winding rule. Shrinking is
+	// done by growing the complement, so the loops are reversed and get a negative weight.
+	double total_area = 0.0;
+	for(size_t i = 0; i < polygon.loops.size(); ++i) {
+		const Vertex<T> *vertices = polygon.GetLoopVertices(i);
+		size_t n = polygon.GetLoopVertexCount(i);
+		double area = 0.0;
+		for(size_t j = 0; j < n; ++j) {
+			Vertex<T> a = vertices[j], b = vertices[(j == n - 1)? 0 : j + 1];
+			area += double(a.x) * double(b.y) - double(a.y) * double(b.x);
+		}
+		total_area += area * double(polygon.loops[i].weight);
+	}
+	bool reverse = ((total_area < 0.0) != (distance < 0.0));
+	W winding_weight = (distance < 0.0)? -1 : 1;
+
+	// generate the offset curves directly in the engine
+	typedef SweepEngine<T, OutputPolicy_Simple<T>, WindingPolicy_Positive<W>> Engine;
+	Engine engine;
+	engine.ResetGenerated([&](typename Engine::LoopSink &sink) {
+		std::vector<Vertex<double>> points;
+		for(size_t i = 0; i < polygon.loops.size(); ++i) {
+			const Vertex<T> *vertices = polygon.GetLoopVertices(i);
+			size_t n = polygon.GetLoopVertexCount(i);
+			if(polygon.loops[i].weight == 0)
+				continue;
+
+			// copy the vertices in the right order, without duplicates
+			bool loop_reverse = (reverse != (polygon.loops[i].weight < 0));
+			points.clear();
+			for(size_t j = 0; j < n; ++j) {
+				Vertex<T> v = vertices[(loop_reverse)? n - 1 - j : j];
+				if(points.empty() || points.back().x != double(v.x) || points.back().y != double(v.y))
+					points.emplace_back(double(v.x), double(v.y));
+			}
+			while(points.size() > 1 && points.back().x == points.front().x && points.back().y == points.front().y) {
+				points.pop_back();
+			}
+			if(points.size() < 3)
+				continue;
+
+			PolygonOffsetLoop(sink, points, abs_distance, join_type, miter_limit, arc_tolerance, winding_weight);
+		}
+	});
+
+	// resolve the curves
+	engine.Process();
+	return engine.Result();
+}
+
+}
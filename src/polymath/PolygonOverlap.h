@@ -0,0 +1,133 @@
+#pragma once
+
+#include "Common.h"
+
+#include "OutputPolicy.h"
+#include "Polygon.h"
+#include "SweepEngine.h"
+#include "Vertex.h"
+#include "WindingPolicy.h"
+
+namespace PolyMath {
+
+// Sweeps both polygons together with a pair of winding numbers and returns whether the region selected by the winding
+// policy has a non-zero area. Zero-width regions between coincident edges of the two polygons are ignored. The sweep
+// stops as soon as the first loop of a non-empty region is closed.
+template<typename WindingPolicy, typename T, typename W>
+bool PolygonPairDetect(const Polygon<T, W> &a, const Polygon<T, W> &b) {
+	typedef SweepEngine<T, OutputPolicy_DetectArea<T>, WindingPolicy> Engine;
+	Engine engine;
+	engine.ResetGenerated([&](typename Engine::LoopSink &sink) {
+		for(size_t i = 0; i < a.loops.size(); ++i) {
+			const Vertex<T> *vertices = a.GetLoopVertices(i);
+			size_t n = a.GetLoopVertexCount(i);
+			for(size_t j = 0; j < n; ++j) {
+				sink.AddVertex(vertices[j]);
+			}
+			sink.AddLoopEnd(WindingPair<W>(a.loops[i].weight, 0));
+		}
+		for(size_t i = 0; i < b.loops.size(); ++i) {
+			const Vertex<T> *vertices = b.GetLoopVertices(i);
+			size_t n = b.GetLoopVertexCount(i);
+			for(size_t j = 0; j < n; ++j) {
+				sink.AddVertex(vertices[j]);
+			}
+			sink.AddLoopEnd(WindingPair<W>(0, b.loops[i].weight));
+		}
+	});
+	return engine.ProcessUntil([&]() { return engine.GetOutputPolicy().IsDetected(); });
+}
+
+// Returns whether the interiors of two polygons overlap (non-zero winding rule). Polygons that only touch don't
+// overlap, including polygons that share an edge. This is much faster than calculating the intersection, because the
+// sweep stops as soon as the first part of the intersection is found, and polygons with disjoint bounding boxes are
+// rejected without a sweep.
+template<typename T, typename W>
+bool PolygonsOverlap(const Polygon<T, W> &a, const Polygon<T, W> &b) {
+
+	// compare bounding boxes
+	auto GetBounds = [](const Polygon<T, W> &poly, Vertex<T> &lo, Vertex<T> &hi) {
+		if(poly.vertices.empty())
+			return false;
+		lo = hi = poly.vertices[0];
+		for(const Vertex<T> &v : poly.vertices) {
+			lo.x = std::min(lo.x, v.x);
+			lo.y = std::min(lo.y, v.y);
+			hi.x = std::max(hi.x, v.x);
+			hi.y = std::max(hi.y, v.y);
+		}
+		return true;
+	};
+	Vertex<T> lo1, hi1, lo2, hi2;
+	if(!GetBounds(a, lo1, hi1) || !GetBounds(b, lo2, hi2))
+		return false;
+	if(hi1.x <= lo2.x || hi2.x <= lo1.x || hi1.y <= lo2.y || hi2.y <= lo1.y)
+		return false;
+
+	return PolygonPairDetect<WindingPolicy_PairBoth<W>>(a, b);
+}
+
+// Returns whether polygon 'a' contains polygon 'b' (non-zero winding rule), i.e. whether no part of the interior of
+// 'b' lies outside 'a'. Shared boundaries are allowed, so every polygon contains itself. The sweep stops at the first
+// part of 'b' outside 'a'.
+template<typename T, typename W>
+bool PolygonContains(const Polygon<T, W> &a, const Polygon<T, W> &b) {
+	return !PolygonPairDetect<WindingPolicy_PairSecondOnly<W>>(a, b);
+}
+
+// Adds the loops of a polygon with the given label offset, such that every loop has winding number 1 on the inside.
+template<typename Sink, typename T, typename W>
+void PolygonOverlapLabelLoops(Sink &sink, const Polygon<T, W> &polygon, size_t label_offset) {
+	for(size_t i = 0; i < polygon.loops.size(); ++i) {
+		if(polygon.loops[i].weight == 0)
+			continue;
+		const Vertex<T> *vertices = polygon.GetLoopVertices(i);
+		size_t n = polygon.GetLoopVertexCount(i);
+		double area = 0.0;
+		for(size_t j = 0; j < n; ++j) {
+			Vertex<T> a = vertices[j], b = vertices[(j == n - 1)? 0 : j + 1];
+			area += double(a.x) * double(b.y) - double(a.y) * double(b.x);
+			sink.AddVertex(a);
+		}
+		sink.AddLoopEnd(typename Sink::WindingWeightType((area < 0.0)? -1 : 1, label_offset + i));
+	}
+}
+
+// Returns all pairs of loops (as sorted pairs of loop indices) that overlap or touch. Every loop is treated as a
+// separate simple polygon regardless of its weight and orientation, so holes are reported as overlapping with their
+// outer loop. All pairs are found with a single sweep: edges of different loops that cross or touch are reported
+// when they meet in the sweep tree, and loops that are nested without touching are found at the leftmost vertex of the
+// inner loop by walking down the tree to the nearest region outside all loops. This is efficient as long as the
+// overlapping clusters are small compared to the whole set, which is the normal case for design rule checks.
+template<typename T, typename W>
+std::vector<std::pair<size_t, size_t>> PolygonOverlapPairs(const Polygon<T, W> &polygon) {
+	typedef SweepEngine<T, OutputPolicy_Detect<T>, WindingPolicy_Labels<default_winding_t>> Engine;
+	Engine engine;
+	engine.ResetGenerated([&](typename Engine::LoopSink &sink) {
+		PolygonOverlapLabelLoops(sink, polygon, 0);
+	});
+	engine.Process();
+	return engine.GetWindingPolicy().GetPairs();
+}
+
+// Same as above, but only returns pairs with one loop of 'a' and one loop of 'b', as (loop of a, loop of b).
+template<typename T, typename W>
+std::vector<std::pair<size_t, size_t>> PolygonOverlapPairs(const Polygon<T, W> &a, const Polygon<T, W> &b) {
+	typedef SweepEngine<T, OutputPolicy_Detect<T>, WindingPolicy_Labels<default_winding_t>> Engine;
+	Engine engine;
+	engine.ResetGenerated([&](typename Engine::LoopSink &sink) {
+		PolygonOverlapLabelLoops(sink, a, 0);
+		PolygonOverlapLabelLoops(sink, b, a.loops.size());
+	});
+	engine.Process();
+	std::vector<std::pair<size_t, size_t>> pairs = engine.GetWindingPolicy().GetPairs();
+	size_t count = 0;
+	for(auto &pair : pairs) {
+		if(pair.first < a.loops.size() && pair.second >= a.loops.size())
+			pairs[count++] = std::make_pair(pair.first, pair.second - a.loops.size());
+	}
+	pairs.resize(count);
+	return pairs;
+}
+
+}
@@ -107,4 +107,60 @@ T PolygonPointEdgeDistance(const Polygon<T, W> &polygon, Vertex<T> point) {
 	return std::sqrt(best);
 }
 
+// Returns the squared distance between a point and a segment, and the closest point on the segment. This is the same
+// projection as in PolygonPointEdgeDistance, but in double precision.
+inline double SegmentPointDistance2(Vertex<double> a, Vertex<double> b, Vertex<double> point, Vertex<double> &closest) {
+	double pos = (point.x - a.x) * (b.x - a.x) + (point.y - a.y) * (b.y - a.y);
+	double len = Square(b.x - a.x) + Square(b.y - a.y);
+	if(pos <= 0.0 || len == 0.0) {
+		closest = a;
+	} else if(pos >= len) {
+		closest = b;
+	} else {
+		closest = Vertex<double>(a.x + (b.x - a.x) * (pos / len), a.y + (b.y - a.y) * (pos / len));
+	}
+	return Square(point.x - closest.x) + Square(point.y - closest.y);
+}
+
+// Returns the squared distance between two segments, and the closest points on both segments. If the segments
+// intersect, the distance is zero and both points are the intersection point. Otherwise the closest pair always
+// includes an endpoint of one of the segments, so only the four endpoint-segment distances have to be checked.
+inline double SegmentSegmentDistance2(Vertex<double> a1, Vertex<double> a2, Vertex<double> b1, Vertex<double> b2, Vertex<double> &point1, Vertex<double> &point2) {
+
+	// check for a proper intersection
+	double da_x = a2.x - a1.x, da_y = a2.y - a1.y, db_x = b2.x - b1.x, db_y = b2.y - b1.y;
+	double o1 = da_x * (b1.y - a1.y) - da_y * (b1.x - a1.x), o2 = da_x * (b2.y - a1.y) - da_y * (b2.x - a1.x);
+	double o3 = db_x * (a1.y - b1.y) - db_y * (a1.x - b1.x), o4 = db_x * (a2.y - b1.y) - db_y * (a2.x - b1.x);
+	if(((o1 < 0.0 && o2 > 0.0) || (o1 > 0.0 && o2 < 0.0)) && ((o3 < 0.0 && o4 > 0.0) || (o3 > 0.0 && o4 < 0.0))) {
+		double t = o3 / (o3 - o4);
+		point1 = point2 = Vertex<double>(a1.x + da_x * t, a1.y + da_y * t);
+		return 0.0;
+	}
+
+	// check the endpoints
+	Vertex<double> closest;
+	double best = SegmentPointDistance2(b1, b2, a1, closest);
+	point1 = a1;
+	point2 = closest;
+	double dist = SegmentPointDistance2(b1, b2, a2, closest);
+	if(dist < best) {
+		best = dist;
+		point1 = a2;
+		point2 = closest;
+	}
+	dist = SegmentPointDistance2(a1, a2, b1, closest);
+	if(dist < best) {
+		best = dist;
+		point1 = closest;
+		point2 = b1;
+	}
+	dist = SegmentPointDistance2(a1, a2, b2, closest);
+	if(dist < best) {
+		best = dist;
+		point1 = closest;
+		point2 = b2;
+	}
+	return best;
+}
+
 }
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "Common.h"
+
+#include "Polygon.h"
+#include "Vertex.h"
+
+namespace PolyMath {
+
+// Temporary memory used by PolygonReduceLoop, so it can be reused for many loops.
+struct PolygonReduceBuffers {
+	std::vector<std::pair<size_t, size_t>> stack;
+	std::vector<uint8_t> keep;
+};
+
+// Removes vertices from a single loop with the Douglas-Peucker algorithm and adds the remaining vertices to the sink.
+// Every point of the reduced loop is within 'tolerance' of the original loop and vice versa, so after the sweep the
+// shape can only change within that distance of the original boundary. The remaining vertices are original vertices,
+// no new coordinates are calculated. Loops that collapse to less than three vertices are dropped. Loops don't depend
+// on each other, so a large polygon can be split into ranges of loops that are reduced in parallel.
+template<typename Sink, typename T>
+void PolygonReduceLoop(Sink &sink, const Vertex<T> *vertices, size_t n, double tolerance, typename Sink::WindingWeightType winding_weight, PolygonReduceBuffers &buffers) {
+
+	if(n < 3)
+		return;
+
+	// squared distance between vertex i and the segment between vertices a and b
+	double tolerance2 = tolerance * tolerance;
+	auto Distance2 = [&](size_t i, size_t a, size_t b) {
+		double px = double(vertices[i].x), py = double(vertices[i].y);
+		double ax = double(vertices[a].x), ay = double(vertices[a].y);
+		double dx = double(vertices[b].x) - ax, dy = double(vertices[b].y) - ay;
+		double len2 = dx * dx + dy * dy, t = 0.0;
+		if(len2 > 0.0)
+			t = std::max(0.0, std::min(1.0, ((px - ax) * dx + (py - ay) * dy) / len2));
+		return Square(px - ax - dx * t) + Square(py - ay - dy * t);
+	};
+
+	// split the loop at the vertex that is furthest from the first vertex
+	size_t split = 0;
+	double split_dist = -1.0;
+	for(size_t i = 1; i < n; ++i) {
+		double dist = Distance2(i, 0, 0);
+		if(dist > split_dist) {
+			split = i;
+			split_dist = dist;
+		}
+	}
+
+	// reduce both halves (index n is the first vertex again)
+	buffers.keep.assign(n, 0);
+	buffers.keep[0] = 1;
+	buffers.keep[split] = 1;
+	buffers.stack.clear();
+	buffers.stack.emplace_back(0, split);
+	buffers.stack.emplace_back(split, n);
+	while(!buffers.stack.empty()) {
+		size_t a = buffers.stack.back().first, b = buffers.stack.back().second;
+		buffers.stack.pop_back();
+		size_t b2 = (b == n)? 0 : b;
+		size_t best = a;
+		double best_dist = tolerance2;
+		for(size_t i = a + 1; i < b; ++i) {
+			double dist = Distance2(i, a, b2);
+			if(dist > best_dist) {
+				best = i;
+				best_dist = dist;
+			}
+		}
+		if(best != a) {
+			buffers.keep[best] = 1;
+			buffers.stack.emplace_back(a, best);
+			buffers.stack.emplace_back(best, b);
+		}
+	}
+
+	// add the remaining vertices
+	size_t count = 0;
+	for(size_t i = 0; i < n; ++i) {
+		count += buffers.keep[i];
+	}
+	if(count < 3)
+		return;
+	for(size_t i = 0; i < n; ++i) {
+		if(buffers.keep[i])
+			sink.AddVertex(vertices[i]);
+	}
+	sink.AddLoopEnd(winding_weight);
+
+}
+
+// Reduces all loops of a polygon, see PolygonReduceLoop. This is intended for oversampled input before it is passed to
+// the sweep engine, but it can also be used on the result.
+template<typename T, typename W>
+void PolygonReduceInto(Polygon<T, W> &result, const Polygon<T, W> &polygon, double tolerance) {
+	assert(&result != &polygon);
+	result.Clear();
+	PolygonReduceBuffers buffers;
+	for(size_t i = 0; i < polygon.loops.size(); ++i) {
+		PolygonReduceLoop(result, polygon.GetLoopVertices(i), polygon.GetLoopVertexCount(i), tolerance, polygon.loops[i].weight, buffers);
+	}
+}
+
+template<typename T, typename W>
+Polygon<T, W> PolygonReduce(const Polygon<T, W> &polygon, double tolerance) {
+	Polygon<T, W> result;
+	PolygonReduceInto(result, polygon, tolerance);
+	return result;
+}
+
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Common.h"
+
+#include "OutputPolicy.h"
+#include "Polygon.h"
+#include "SweepEngine.h"
+#include "Vertex.h"
+#include "WindingPolicy.h"
+
+namespace PolyMath {
+
+enum ValidationIssueType {
+	VALIDATIONISSUE_INTERSECTION, // two edges cross each other
+	VALIDATIONISSUE_OVERLAP, // a region is covered by more than one loop (winding number other than 0, 1 and -1)
+};
+
+template<typename T>
+struct ValidationIssue {
+	ValidationIssueType type;
+	Vertex<T> vertex;
+};
+
+// Checks whether a polygon is valid, i.e. none of its edges cross and no region is covered more than once, so it can
+// be used directly without simplifying it first. Touching vertices and edges are allowed. This runs the sweep without
+// generating any output and stops as soon as 'max_issues' issues have been found, so valid inputs cost about as much as
+// sorting the vertices and maintaining the sweep tree. The issues are returned with the position where they were
+// detected. Returns whether no issues were found. Only the sign of the loop weights matters: the loops are added with
+// weight 1 or -1 (and loops with weight 0 are ignored), so the winding number counts loops and a single loop with
+// weight 2 is still valid. Duplicate vertices and an explicit closing vertex are allowed.
+template<typename T, typename W>
+bool PolygonValidate(const Polygon<T, W> &polygon, std::vector<ValidationIssue<T>> &issues, size_t max_issues = 1) {
+	assert(max_issues != 0);
+	typedef SweepEngine<T, OutputPolicy_Detect<T>, WindingPolicy_Validate<W>> Engine;
+	Engine engine;
+	engine.ResetGenerated([&](typename Engine::LoopSink &sink) {
+		for(size_t i = 0; i < polygon.loops.size(); ++i) {
+			W weight = polygon.loops[i].weight;
+			if(weight == 0)
+				continue;
+			// skip duplicate vertices (including a closing vertex that repeats the first one), since the zero-length
+			// edges would be counted as intersections
+			const Vertex<T> *vertices = polygon.GetLoopVertices(i);
+			size_t n = polygon.GetLoopVertexCount(i);
+			while(n > 1 && vertices[n - 1].x == vertices[0].x && vertices[n - 1].y == vertices[0].y) {
+				--n;
+			}
+			for(size_t j = 0; j < n; ++j) {
+				if(j == 0 || vertices[j].x != vertices[j - 1].x || vertices[j].y != vertices[j - 1].y)
+					sink.AddVertex(vertices[j]);
+			}
+			sink.AddLoopEnd((weight > 0)? W(1) : W(-1));
+		}
+	});
+	issues.clear();
+	size_t intersections = 0;
+	engine.ProcessUntil([&]() {
+		if(engine.GetIntersectionCount() != intersections) {
+			intersections = engine.GetIntersectionCount();
+			issues.push_back(ValidationIssue<T>{VALIDATIONISSUE_INTERSECTION, engine.GetEventVertex()});
+		}
+		if(engine.GetWindingPolicy().HasOverlap() && issues.size() < max_issues) {
+			engine.GetWindingPolicy().ClearOverlap();
+			issues.push_back(ValidationIssue<T>{VALIDATIONISSUE_OVERLAP, engine.GetEventVertex()});
+		}
+		return (issues.size() >= max_issues);
+	});
+	return issues.empty();
+}
+
+template<typename T, typename W>
+bool PolygonValidate(const Polygon<T, W> &polygon) {
+	std::vector<ValidationIssue<T>> issues;
+	return PolygonValidate(polygon, issues, 1);
+}
+
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "Common.h"
+
+#include "Vertex.h"
+
+namespace PolyMath {
+
+// A set of open paths. Unlike the loops of a polygon, paths are not closed and have no winding weight.
+template<typename T>
+struct Polyline {
+
+	typedef T ValueType;
+	typedef Vertex<T> VertexType;
+
+	std::vector<VertexType> vertices;
+	std::vector<size_t> path_ends;
+
+	Polyline() = default;
+	Polyline(const Polyline &other) = default;
+	Polyline(Polyline &&other) = default;
+
+	Polyline(const std::vector<VertexType> &vertices, const std::vector<size_t> &path_ends)
+		: vertices(vertices), path_ends(path_ends) {}
+
+	Polyline(std::initializer_list<std::initializer_list<VertexType>> data) {
+		for(auto path : data) {
+			for(VertexType v : path) {
+				AddVertex(v);
+			}
+			AddPathEnd();
+		}
+	}
+
+	Polyline& operator=(const Polyline &other) = default;
+	Polyline& operator=(Polyline &&other) = default;
+
+	bool IsValid() const {
+		size_t last = 0;
+		for(size_t i = 0; i < path_ends.size(); ++i) {
+			if(path_ends[i] < last)
+				return false;
+			last = path_ends[i];
+		}
+		return (last == vertices.size());
+	}
+
+	void Clear() {
+		vertices.clear();
+		path_ends.clear();
+	}
+	void AddVertex(VertexType v) {
+		vertices.push_back(v);
+	}
+	void AddPathEnd() {
+		path_ends.push_back(vertices.size());
+	}
+
+	VertexType* GetPathVertices(size_t i) {
+		assert(i < path_ends.size());
+		return (i == 0)? vertices.data() : vertices.data() + path_ends[i - 1];
+	}
+	const VertexType* GetPathVertices(size_t i) const {
+		assert(i < path_ends.size());
+		return (i == 0)? vertices.data() : vertices.data() + path_ends[i - 1];
+	}
+	size_t GetPathVertexCount(size_t i) const {
+		assert(i < path_ends.size());
+		return (i == 0)? path_ends[i] : path_ends[i] - path_ends[i - 1];
+	}
+
+	friend std::ostream& operator<<(std::ostream &stream, const Polyline &p) {
+		if(p.IsValid()) {
+			stream << "Polyline([";
+			for(size_t i = 0; i < p.path_ends.size(); i++) {
+				if(i != 0)
+					stream << ", ";
+				stream << "Path([";
+				const VertexType *vertices = p.GetPathVertices(i);
+				size_t n = p.GetPathVertexCount(i);
+				for(size_t j = 0; j < n; ++j) {
+					if(j != 0)
+						stream << ", ";
+					stream << vertices[j];
+				}
+				stream << "])";
+			}
+			stream << "])";
+		} else {
+			stream << "Polyline(<invalid>)";
+		}
+		return stream;
+	}
+
+};
+
+}
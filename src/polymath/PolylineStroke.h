@@ -0,0 +1,108 @@
+#pragma once
+
+#include "Common.h"
+
+#include "OutputPolicy.h"
+#include "Polygon.h"
+#include "PolygonOffset.h"
+#include "Polyline.h"
+#include "SweepEngine.h"
+#include "Vertex.h"
+#include "WindingPolicy.h"
+
+namespace PolyMath {
+
+enum StrokeCapType {
+	STROKECAP_BUTT,
+	STROKECAP_SQUARE,
+	STROKECAP_ROUND,
+};
+
+// Generates the outline of every path of the polyline as a single counterclockwise loop with weight 1. The outline
+// follows the right side of the path forward and the left side backward, with joins on the outside of each turn and
+// caps at both ends. It may intersect itself, but the winding number is positive exactly in the stroked region, so the
+// union of all strokes is obtained with the positive winding rule. Paths with less than two distinct vertices are
+// ignored.
+template<typename Sink, typename T>
+void PolylineStrokeLoops(Sink &sink, const Polyline<T> &polyline, double width, OffsetJoinType join_type = OFFSETJOIN_ROUND, StrokeCapType cap_type = STROKECAP_ROUND, double miter_limit = 2.0, double arc_tolerance = 0.0) {
+	typedef typename Sink::ValueType T2;
+
+	double distance = 0.5 * std::fabs(width);
+	if(arc_tolerance <= 0.0)
+		arc_tolerance = distance * 0.002;
+	double step_angle = PolygonOffsetStepAngle(distance, arc_tolerance);
+	OffsetJoinType cap_join_type = (cap_type == STROKECAP_SQUARE)? OFFSETJOIN_SQUARE : OFFSETJOIN_ROUND;
+
+	std::vector<Vertex<double>> points, directions;
+	for(size_t i = 0; i < polyline.path_ends.size(); ++i) {
+		const Vertex<T> *vertices = polyline.GetPathVertices(i);
+		size_t n = polyline.GetPathVertexCount(i);
+
+		// copy the vertices without duplicates
+		points.clear();
+		for(size_t j = 0; j < n; ++j) {
+			Vertex<T> v = vertices[j];
+			if(points.empty() || points.back().x != double(v.x) || points.back().y != double(v.y))
+				points.emplace_back(double(v.x), double(v.y));
+		}
+		size_t m = points.size();
+		if(m < 2)
+			continue;
+
+		// calculate edge directions
+		directions.resize(m - 1);
+		for(size_t j = 0; j < m - 1; ++j) {
+			double len = std::hypot(points[j + 1].x - points[j].x, points[j + 1].y - points[j].y);
+			directions[j] = Vertex<double>((points[j + 1].x - points[j].x) / len, (points[j + 1].y - points[j].y) / len);
+		}
+
+		// right side, forward
+		for(size_t j = 1; j < m - 1; ++j) {
+			PolygonOffsetJoin(sink, points[j], directions[j - 1], directions[j], distance, join_type, miter_limit, arc_tolerance, step_angle);
+		}
+
+		// end cap
+		Vertex<double> d = directions[m - 2], p = points[m - 1];
+		if(cap_type == STROKECAP_BUTT) {
+			sink.AddVertex(Vertex<T2>(ConvertFromDouble<T2>(p.x + d.y * distance), ConvertFromDouble<T2>(p.y - d.x * distance)));
+			sink.AddVertex(Vertex<T2>(ConvertFromDouble<T2>(p.x - d.y * distance), ConvertFromDouble<T2>(p.y + d.x * distance)));
+		} else {
+			PolygonOffsetJoin(sink, p, d, Vertex<double>(-d.x, -d.y), distance, cap_join_type, miter_limit, arc_tolerance, step_angle);
+		}
+
+		// left side, backward
+		for(size_t j = m - 2; j > 0; --j) {
+			Vertex<double> d1 = directions[j], d2 = directions[j - 1];
+			PolygonOffsetJoin(sink, points[j], Vertex<double>(-d1.x, -d1.y), Vertex<double>(-d2.x, -d2.y), distance, join_type, miter_limit, arc_tolerance, step_angle);
+		}
+
+		// start cap
+		d = directions[0];
+		p = points[0];
+		if(cap_type == STROKECAP_BUTT) {
+			sink.AddVertex(Vertex<T2>(ConvertFromDouble<T2>(p.x - d.y * distance), ConvertFromDouble<T2>(p.y + d.x * distance)));
+			sink.AddVertex(Vertex<T2>(ConvertFromDouble<T2>(p.x + d.y * distance), ConvertFromDouble<T2>(p.y - d.x * distance)));
+		} else {
+			PolygonOffsetJoin(sink, p, Vertex<double>(-d.x, -d.y), d, distance, cap_join_type, miter_limit, arc_tolerance, step_angle);
+		}
+
+		sink.AddLoopEnd(1);
+	}
+
+}
+
+// Strokes all paths of the polyline with the given width and returns the union of the strokes. The miter limit is
+// relative to half of the width. The arc tolerance is the maximum deviation of round joins and caps, zero selects 1/500
+// of half of the width. The outlines are fed directly into the sweep engine, so no intermediate polygon is built.
+template<typename T>
+Polygon<T> PolylineStroke(const Polyline<T> &polyline, double width, OffsetJoinType join_type = OFFSETJOIN_ROUND, StrokeCapType cap_type = STROKECAP_ROUND, double miter_limit = 2.0, double arc_tolerance = 0.0) {
+	typedef SweepEngine<T, OutputPolicy_Simple<T>, WindingPolicy_Positive<default_winding_t>> Engine;
+	Engine engine;
+	engine.ResetGenerated([&](typename Engine::LoopSink &sink) {
+		PolylineStrokeLoops(sink, polyline, width, join_type, cap_type, miter_limit, arc_tolerance);
+	});
+	engine.Process();
+	return engine.Result();
+}
+
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Common.h"
+
+#include "OutputPolicy.h"
+#include "SweepEngine.h"
+#include "Vertex.h"
+#include "WindingPolicy.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace PolyMath {
+
+template<typename T>
+struct SegmentIntersection {
+	size_t segment1, segment2; // segment1 < segment2
+	Vertex<T> vertex;
+};
+
+// Returns all crossings between the given segments, with the indices of both segments and the intersection point
+// (rounded to the vertex type). This is the Bentley-Ottmann sweep of the engine with every segment added as an open
+// path, so it uses the same exact predicates and costs O((n + k) log n) for n segments and k crossings. By default only
+// proper crossings are reported, where the segments swap places in the sweep. Segments that merely touch (e.g. at a
+// shared endpoint, or an endpoint on the other segment) or overlap collinearly are only reported if 'touching' is
+// set, once per pair, with an endpoint of one segment that lies on the other as the intersection point. Zero-length
+// segments are ignored.
+template<typename T>
+std::vector<SegmentIntersection<T>> SegmentIntersections(const std::vector<std::pair<Vertex<T>, Vertex<T>>> &segments, bool touching = false) {
+	typedef SweepEngine<T, OutputPolicy_Detect<T>, WindingPolicy_NonZero<default_winding_t>> Engine;
+	Engine engine;
+	std::vector<size_t> ids;
+	engine.ResetGenerated([&](typename Engine::LoopSink &sink) {
+		for(size_t i = 0; i < segments.size(); ++i) {
+			Vertex<T> a = segments[i].first, b = segments[i].second;
+			if(a.x == b.x && a.y == b.y)
+				continue;
+			sink.AddVertex(a);
+			sink.AddVertex(b);
+			sink.AddPathEnd();
+			ids.push_back(i);
+		}
+	});
+	engine.SetRecordPathCrossings(true);
+	engine.SetRecordPathContacts(touching);
+	engine.Process();
+
+	// returns whether c and d are strictly on opposite sides of the line through a and b
+	auto Opposite = [](Vertex<T> a, Vertex<T> b, Vertex<T> c, Vertex<T> d) {
+		return (NumericalEngine<T>::OrientationTest(a.x, a.y, b.x, b.y, c.x, c.y, true) && NumericalEngine<T>::OrientationTest(b.x, b.y, a.x, a.y, d.x, d.y, true)) ||
+			(NumericalEngine<T>::OrientationTest(b.x, b.y, a.x, a.y, c.x, c.y, true) && NumericalEngine<T>::OrientationTest(a.x, a.y, b.x, b.y, d.x, d.y, true));
+	};
+
+	// Convert the segment indices. The sweep also swaps some segments that only touch, because vertices are processed
+	// after the intersections at the same X coordinate, so those are filtered out with an exact test.
+	std::vector<SegmentIntersection<T>> result;
+	result.reserve(engine.GetPathCrossings().size());
+	for(const typename Engine::PathCrossing &crossing : engine.GetPathCrossings()) {
+		size_t path1, path2, vertex;
+		engine.GetPathSegment(crossing.m_segment1, path1, vertex);
+		engine.GetPathSegment(crossing.m_segment2, path2, vertex);
+		const std::pair<Vertex<T>, Vertex<T>> &s1 = segments[ids[path1]], &s2 = segments[ids[path2]];
+		if(!Opposite(s1.first, s1.second, s2.first, s2.second) || !Opposite(s2.first, s2.second, s1.first, s1.second))
+			continue;
+		result.push_back(SegmentIntersection<T>{std::min(ids[path1], ids[path2]), std::max(ids[path1], ids[path2]), crossing.m_vertex});
+	}
+
+	// Touching segments can be found at more than one endpoint. Proper crossings can't touch, so they are never
+	// duplicates.
+	if(touching) {
+		size_t crossings = result.size();
+		for(const typename Engine::PathCrossing &contact : engine.GetPathContacts()) {
+			size_t path1, path2, vertex;
+			engine.GetPathSegment(contact.m_segment1, path1, vertex);
+			engine.GetPathSegment(contact.m_segment2, path2, vertex);
+			result.push_back(SegmentIntersection<T>{std::min(ids[path1], ids[path2]), std::max(ids[path1], ids[path2]), contact.m_vertex});
+		}
+		auto Less = [](const SegmentIntersection<T> &a, const SegmentIntersection<T> &b) {
+			return (a.segment1 != b.segment1)? a.segment1 < b.segment1 : a.segment2 < b.segment2;
+		};
+		auto Equal = [](const SegmentIntersection<T> &a, const SegmentIntersection<T> &b) {
+			return a.segment1 == b.segment1 && a.segment2 == b.segment2;
+		};
+		std::stable_sort(result.begin() + crossings, result.end(), Less);
+		result.erase(std::unique(result.begin() + crossings, result.end(), Equal), result.end());
+	}
+
+	return result;
+}
+
+}
@@ -4,13 +4,16 @@
 
 #include "NumericalEngine.h"
 #include "Polygon.h"
+#include "Polyline.h"
 #include "SweepTree.h"
 #include "Vertex.h"
 #include "Visualization.h"
+#include "WindingPolicy.h"
 
 #include <algorithm>
 #include <limits>
 #include <memory>
+#include <type_traits>
 
 #define POLYMATH_VERIFY 0
 
@@ -64,6 +67,9 @@ private:
 		SweepVertex *m_loop_prev, *m_loop_next;
 		bool m_edge_forward;
 
+		// open path (the last vertex has no edge to the first vertex)
+		bool m_path, m_path_last;
+
 		// sweep edge
 		SweepEdge *m_sweep_edge;
 
@@ -82,23 +88,78 @@ private:
 		WindingWeightType m_winding_weight;
 		WindingNumberType m_winding_number;
 
+		// open path segment (index of the first vertex of the segment, INDEX_NONE for loop edges)
+		size_t m_path_segment;
+
 		// output
 		typename OutputPolicy::OutputEdge m_output_edge;
 
 	};
 
+	struct PathRange {
+		size_t m_begin, m_end;
+	};
+
+	struct PathEvent {
+		size_t m_segment;
+		VertexType m_vertex;
+		bool m_inside; // state of the path after this vertex, in sweep order
+	};
+
+	struct PathVertical {
+		VertexType m_bottom, m_top;
+	};
+
+public:
+	// A crossing between two open path segments, see SetRecordPathCrossings. The segments are identified by the index
+	// of their first vertex, GetPathSegment converts this to a path index and a vertex index within the path.
+	struct PathCrossing {
+		size_t m_segment1, m_segment2;
+		VertexType m_vertex;
+	};
+
 private:
 	static constexpr size_t SWEEP_EDGE_BATCH_SIZE = 256;
+	static constexpr size_t VERTEX_SORT_BATCH_SIZE = 1024;
 
 private:
 
 	// input vertices
 	std::vector<SweepVertex> m_vertex_pool;
+	std::vector<size_t> m_loop_ends; // only used for generated loops
+	std::vector<PathRange> m_paths;
+
+	// whether all edges are horizontal or vertical, in which case NumericalEngine_Rectilinear is used
+	bool m_rectilinear;
+
+	// open path output
+	std::vector<PathEvent> m_path_events;
+	std::vector<size_t> m_path_vertical_events; // events on vertical segments that don't have a state yet
+	std::vector<PathCrossing> m_path_crossings;
+	std::vector<PathCrossing> m_path_contacts;
+	bool m_record_path_crossings;
+	bool m_record_path_contacts;
+
+	// path segments with an end vertex at the current position (only used to record contacts)
+	std::vector<size_t> m_path_end_segments;
+	VertexType m_path_end_vertex;
+
+	// vertical edges at the current position (only used by WindingPolicy_Labels)
+	std::vector<SweepVertex*> m_label_verticals;
+
+	// vertical loop edges and vertical open path edges at the current position
+	std::vector<PathVertical> m_path_loop_verticals;
+	std::vector<SweepEdge*> m_path_verticals;
 
 	// sorted vertices
 	std::vector<SweepVertex*> m_vertex_queue;
+	size_t m_vertex_queue_sorted;
 	size_t m_current_vertex;
 
+	// statistics of the current run
+	size_t m_intersection_count;
+	VertexType m_event_vertex;
+
 	// sweep edges
 	std::vector<std::unique_ptr<SweepEdge[]>> m_sweep_edge_batches;
 	SweepEdge *m_sweep_edge_free_list;
@@ -139,8 +200,15 @@ private:
 
 	}
 
+	// Orientation test where (a, b) is always an edge, so the rectilinear version can be used when possible.
+	bool OrientationTest(ValueType a_x, ValueType a_y, ValueType b_x, ValueType b_y, ValueType c_x, ValueType c_y, bool strict) const {
+		if(m_rectilinear)
+			return NumericalEngine_Rectilinear<T>::OrientationTest(a_x, a_y, b_x, b_y, c_x, c_y, strict);
+		return NumericalEngine<T>::OrientationTest(a_x, a_y, b_x, b_y, c_x, c_y, strict);
+	}
+
 	// The 'less than' operator for an active edge and a vertex. This is used to insert new points in the search tree.
-	static bool CompareEdgeVertex(SweepEdge *edge, SweepVertex *vertex) {
+	bool CompareEdgeVertex(SweepEdge *edge, SweepVertex *vertex) {
 
 		// get points
 		ValueType a1_x = edge->m_vertex_first.x;
@@ -153,12 +221,12 @@ private:
 		assert(b_x <= a2_x);
 
 		// test
-		return NumericalEngine<T>::OrientationTest(a1_x, a1_y, a2_x, a2_y, b_x, b_y, true);
+		return OrientationTest(a1_x, a1_y, a2_x, a2_y, b_x, b_y, true);
 
 	}
 
 	// Calculates the intersection between two edges.
-	static bool IntersectEdgeEdge(SweepEdge *edge1, SweepEdge *edge2, DoubleVertexType &result) {
+	bool IntersectEdgeEdge(SweepEdge *edge1, SweepEdge *edge2, DoubleVertexType &result) {
 		assert(edge1 != edge2);
 
 		// get points
@@ -177,7 +245,9 @@ private:
 
 		// test
 		DoubleValueType res_x, res_y;
-		if(NumericalEngine<T>::IntersectionTest(a1_x, a1_y, a2_x, a2_y, b1_x, b1_y, b2_x, b2_y, res_x, res_y)) {
+		bool intersect = (m_rectilinear)? NumericalEngine_Rectilinear<T>::IntersectionTest(a1_x, a1_y, a2_x, a2_y, b1_x, b1_y, b2_x, b2_y, res_x, res_y) :
+				NumericalEngine<T>::IntersectionTest(a1_x, a1_y, a2_x, a2_y, b1_x, b1_y, b2_x, b2_y, res_x, res_y);
+		if(intersect) {
 			result = DoubleVertexType(res_x, res_y);
 			return true;
 		}
@@ -422,6 +492,271 @@ private:
 		return &edge->m_output_edge;
 	}
 
+	typename OutputPolicy::OutputEdge* FindPrevOutputEdgeOrNull(SweepEdge *edge) {
+		while(edge != nullptr && !m_output_policy.HasOutputEdge(edge->m_output_edge)) {
+			edge = m_tree.TreePrevious(edge);
+		}
+		return (edge == nullptr)? nullptr : &edge->m_output_edge;
+	}
+
+	typename OutputPolicy::OutputEdge* FindNextOutputEdgeOrNull(SweepEdge *edge) {
+		while(edge != nullptr && !m_output_policy.HasOutputEdge(edge->m_output_edge)) {
+			edge = m_tree.TreeNext(edge);
+		}
+		return (edge == nullptr)? nullptr : &edge->m_output_edge;
+	}
+
+	bool EdgeTouchesVertex(SweepEdge *edge, VertexType c) const {
+		VertexType a = edge->m_vertex_first, b = edge->m_vertex_last;
+		if(c.x < std::min(a.x, b.x) || c.x > std::max(a.x, b.x) || c.y < std::min(a.y, b.y) || c.y > std::max(a.y, b.y))
+			return false;
+		return OrientationTest(a.x, a.y, b.x, b.y, c.x, c.y, false) && !OrientationTest(a.x, a.y, b.x, b.y, c.x, c.y, true);
+	}
+
+	// Returns whether an open path edge is inside the result. The order of coincident edges in the tree is arbitrary,
+	// so a path that lies on top of loop edges would otherwise be inside or outside depending on which side of the
+	// boundary it ends up. Instead, such a path counts as inside if any of the regions around the coincident edges is
+	// inside, i.e. the boundary of the result is considered to be part of the result.
+	bool IsPathEdgeInside(SweepEdge *edge, VertexType vertex) {
+		auto Coincident = [this, edge](SweepEdge *other) {
+			VertexType a = edge->m_vertex_first, b = edge->m_vertex_last;
+			VertexType c = other->m_vertex_first, d = other->m_vertex_last;
+			return OrientationTest(a.x, a.y, b.x, b.y, c.x, c.y, false) && !OrientationTest(a.x, a.y, b.x, b.y, c.x, c.y, true) &&
+					OrientationTest(a.x, a.y, b.x, b.y, d.x, d.y, false) && !OrientationTest(a.x, a.y, b.x, b.y, d.x, d.y, true);
+		};
+		// other open paths that pass through the vertex may end up between the coincident edges, they can be skipped
+		// because they don't change the winding number
+		SweepEdge *edge_first = edge, *edge_last = edge;
+		for(SweepEdge *prev = m_tree.TreePrevious(edge); prev != nullptr; prev = m_tree.TreePrevious(prev)) {
+			if(Coincident(prev)) {
+				edge_first = prev;
+			} else if(prev->m_path_segment == INDEX_NONE || !EdgeTouchesVertex(prev, vertex)) {
+				break;
+			}
+		}
+		for(SweepEdge *next = m_tree.TreeNext(edge); next != nullptr; next = m_tree.TreeNext(next)) {
+			if(Coincident(next)) {
+				edge_last = next;
+			} else if(next->m_path_segment == INDEX_NONE || !EdgeTouchesVertex(next, vertex)) {
+				break;
+			}
+		}
+		SweepEdge *edge_prev = m_tree.TreePrevious(edge_first);
+		if(m_winding_policy.Evaluate((edge_prev == nullptr)? WindingNumberType(0) : edge_prev->m_winding_number))
+			return true;
+		for(SweepEdge *e = edge_first; ; e = m_tree.TreeNext(e)) {
+			if(m_winding_policy.Evaluate(e->m_winding_number))
+				return true;
+			if(e == edge_last)
+				return false;
+		}
+	}
+
+	void AddPathEvent(SweepEdge *edge, VertexType vertex) {
+		if(edge->m_path_segment != INDEX_NONE) {
+			if(edge->m_vertex_first.x == edge->m_vertex_last.x) {
+				m_path_vertical_events.push_back(m_path_events.size());
+				m_path_events.push_back(PathEvent{edge->m_path_segment, vertex, false});
+			} else {
+				m_path_events.push_back(PathEvent{edge->m_path_segment, vertex, IsPathEdgeInside(edge, vertex)});
+			}
+		}
+	}
+
+	// Returns a value between a and b (with a < b) without overflowing.
+	static T PathMidpoint(T a, T b, std::true_type) {
+		return a + (b - a) / T(2);
+	}
+	static T PathMidpoint(T a, T b, std::false_type) {
+		typedef typename std::make_unsigned<T>::type U;
+		return T(a + T((U(b) - U(a)) / U(2)));
+	}
+
+	// Returns whether the region just to the right of the point is inside, or the point lies on a vertical loop edge.
+	bool IsPathVerticalInside(VertexType vertex) {
+		for(const PathVertical &vertical : m_path_loop_verticals) {
+			if(vertical.m_bottom.x == vertex.x && vertical.m_bottom.y <= vertex.y && vertex.y <= vertical.m_top.y)
+				return true;
+		}
+		SweepEdge *below = m_tree.TreeFindLast([this, vertex](SweepEdge *edge) {
+			return OrientationTest(edge->m_vertex_first.x, edge->m_vertex_first.y, edge->m_vertex_last.x, edge->m_vertex_last.y, vertex.x, vertex.y, false);
+		});
+		return m_winding_policy.Evaluate((below == nullptr)? WindingNumberType(0) : below->m_winding_number);
+	}
+
+	// Vertical edges aren't ordered in the tree, so the state of events on vertical path edges is only determined once
+	// all events at their X coordinate have been processed. At that point the tree only contains the edges to the right
+	// of the vertical edges, and the state of each piece is taken from its midpoint. Intersection events are rounded,
+	// so the events themselves may end up on the wrong side of the edge that caused them.
+	void FinishPathVerticals() {
+		std::sort(m_path_vertical_events.begin(), m_path_vertical_events.end(), [this](size_t a, size_t b) {
+			const PathEvent &event1 = m_path_events[a], &event2 = m_path_events[b];
+			return (event1.m_segment != event2.m_segment)? event1.m_segment < event2.m_segment : event1.m_vertex.y < event2.m_vertex.y;
+		});
+		for(size_t i = 0; i < m_path_vertical_events.size(); ) {
+			size_t segment = m_path_events[m_path_vertical_events[i]].m_segment;
+			VertexType v = m_path_events[m_path_vertical_events[i]].m_vertex;
+			T top = std::max(m_vertex_pool[segment].m_vertex.y, m_vertex_pool[segment + 1].m_vertex.y);
+			size_t j = i + 1;
+			while(j < m_path_vertical_events.size() && m_path_events[m_path_vertical_events[j]].m_segment == segment &&
+					!(v.y < m_path_events[m_path_vertical_events[j]].m_vertex.y)) {
+				++j;
+			}
+			T next = (j < m_path_vertical_events.size() && m_path_events[m_path_vertical_events[j]].m_segment == segment)?
+					m_path_events[m_path_vertical_events[j]].m_vertex.y : top;
+			bool inside = (v.y < next)? IsPathVerticalInside(VertexType(v.x, PathMidpoint(v.y, next, std::is_floating_point<T>()))) : false;
+			for( ; i < j; ++i) {
+				m_path_events[m_path_vertical_events[i]].m_inside = inside;
+			}
+		}
+		m_path_vertical_events.clear();
+	}
+
+	// Called before each event, finishes the vertical path edges of the previous X coordinate.
+	void UpdatePathColumn(VertexType vertex) {
+		if(!m_path_vertical_events.empty() && m_path_events[m_path_vertical_events[0]].m_vertex.x < vertex.x)
+			FinishPathVerticals();
+	}
+
+	// Records the open path segments that touch the first or last vertex of a path, see SetRecordPathContacts. Segments
+	// that end at the same position may already be removed from the tree, so they are tracked separately.
+	void AddPathContacts(VertexType vertex, size_t segment, SweepEdge *edge_prev, SweepEdge *edge_next) {
+		if(m_path_end_segments.empty() || m_path_end_vertex.x != vertex.x || m_path_end_vertex.y != vertex.y) {
+			m_path_end_segments.clear();
+			m_path_end_vertex = vertex;
+		}
+		for(size_t other : m_path_end_segments) {
+			if(other != segment)
+				m_path_contacts.push_back(PathCrossing{other, segment, vertex});
+		}
+		m_path_end_segments.push_back(segment);
+		for(SweepEdge *edge = edge_prev; edge != nullptr && EdgeTouchesVertex(edge, vertex); edge = m_tree.TreePrevious(edge)) {
+			if(edge->m_path_segment != INDEX_NONE && edge->m_path_segment != segment)
+				m_path_contacts.push_back(PathCrossing{edge->m_path_segment, segment, vertex});
+		}
+		for(SweepEdge *edge = edge_next; edge != nullptr && EdgeTouchesVertex(edge, vertex); edge = m_tree.TreeNext(edge)) {
+			if(edge->m_path_segment != INDEX_NONE && edge->m_path_segment != segment)
+				m_path_contacts.push_back(PathCrossing{edge->m_path_segment, segment, vertex});
+		}
+		for(SweepEdge *edge : m_path_verticals) {
+			// edges that end here are already covered by the list above
+			VertexType top = edge->m_vertex_last;
+			if(edge->m_path_segment != segment && edge->m_vertex_first.x == top.x && top.y > vertex.y && EdgeTouchesVertex(edge, vertex))
+				m_path_contacts.push_back(PathCrossing{edge->m_path_segment, segment, vertex});
+		}
+	}
+
+	// The state of an open path can also change at a loop vertex that lies on the path without crossing it, e.g. where
+	// the path starts or stops following a loop edge. The edges that touch the vertex are next to it in the tree, except
+	// for vertical edges (see ReportLabelVertex), which are tracked separately.
+	void AddTouchingPathEvents(VertexType vertex, SweepEdge *edge_prev, SweepEdge *edge_next) {
+		if(m_paths.empty())
+			return;
+		for(SweepEdge *edge = edge_prev; edge != nullptr && EdgeTouchesVertex(edge, vertex); edge = m_tree.TreePrevious(edge)) {
+			AddPathEvent(edge, vertex);
+		}
+		for(SweepEdge *edge = edge_next; edge != nullptr && EdgeTouchesVertex(edge, vertex); edge = m_tree.TreeNext(edge)) {
+			AddPathEvent(edge, vertex);
+		}
+		for(SweepEdge *edge : m_path_verticals) {
+			// edges that end here may already be removed, and the state after the end doesn't matter anyway
+			VertexType top = edge->m_vertex_last;
+			if(edge->m_vertex_first.x == top.x && top.y > vertex.y && EdgeTouchesVertex(edge, vertex))
+				AddPathEvent(edge, vertex);
+		}
+	}
+
+	// Updates the vertical edges at the current position before a vertex is processed. Vertical open path edges are
+	// added after the vertex is processed, because the sweep edges don't exist before that.
+	void UpdatePathVerticals(SweepVertex *vertex) {
+		VertexType v = vertex->m_vertex;
+		if(!m_path_loop_verticals.empty() && m_path_loop_verticals[0].m_bottom.x != v.x)
+			m_path_loop_verticals.clear();
+		if(!m_path_verticals.empty() && m_path_verticals[0]->m_vertex_first.x != v.x)
+			m_path_verticals.clear();
+		m_path_verticals.erase(std::remove_if(m_path_verticals.begin(), m_path_verticals.end(),
+				[v](SweepEdge *edge) { return edge->m_vertex_first.x != edge->m_vertex_last.x || edge->m_vertex_last.y < v.y; }), m_path_verticals.end());
+		if(!vertex->m_path) {
+			if(vertex->m_loop_prev->m_vertex.x == v.x && vertex->m_loop_prev->m_vertex.y > v.y)
+				m_path_loop_verticals.push_back(PathVertical{v, vertex->m_loop_prev->m_vertex});
+			if(vertex->m_loop_next->m_vertex.x == v.x && vertex->m_loop_next->m_vertex.y > v.y)
+				m_path_loop_verticals.push_back(PathVertical{v, vertex->m_loop_next->m_vertex});
+		}
+	}
+
+	void AddPathVerticals(SweepVertex *vertex) {
+		VertexType v = vertex->m_vertex;
+		if(!vertex->m_path_last && vertex->m_loop_next->m_vertex.x == v.x && vertex->m_loop_next->m_vertex.y > v.y)
+			m_path_verticals.push_back(vertex->m_sweep_edge);
+		if(!vertex->m_loop_prev->m_path_last && vertex->m_loop_prev->m_vertex.x == v.x && vertex->m_loop_prev->m_vertex.y > v.y)
+			m_path_verticals.push_back(vertex->m_loop_prev->m_sweep_edge);
+	}
+
+	// Label callbacks, these are only used by WindingPolicy_Labels.
+	void ReportLabelCrossing(std::false_type, SweepEdge*, SweepEdge*) {}
+	void ReportLabelCrossing(std::true_type, SweepEdge *edge1, SweepEdge *edge2) {
+		m_winding_policy.AddPair(edge1->m_winding_weight.label, edge2->m_winding_weight.label);
+	}
+
+	void ReportLabelVertex(std::false_type, SweepVertex*, SweepEdge*, SweepEdge*, bool) {}
+	void ReportLabelVertex(std::true_type, SweepVertex *vertex, SweepEdge *edge_prev, SweepEdge *edge_next, bool start) {
+		size_t label = vertex->m_winding_weight.label;
+
+		// edges that touch the vertex
+		for(SweepEdge *edge = edge_prev; edge != nullptr && EdgeTouchesVertex(edge, vertex->m_vertex); edge = m_tree.TreePrevious(edge)) {
+			m_winding_policy.AddPair(label, edge->m_winding_weight.label);
+		}
+		for(SweepEdge *edge = edge_next; edge != nullptr && EdgeTouchesVertex(edge, vertex->m_vertex); edge = m_tree.TreeNext(edge)) {
+			m_winding_policy.AddPair(label, edge->m_winding_weight.label);
+		}
+
+		// Vertical edges are not ordered correctly in the tree, because all intersections at the same X coordinate are
+		// processed before the vertices. Instead, the vertical edges that contain the current position are tracked
+		// separately (represented by their top vertex).
+		if(!m_label_verticals.empty() && m_label_verticals[0]->m_vertex.x != vertex->m_vertex.x)
+			m_label_verticals.clear();
+		size_t count = 0;
+		for(SweepVertex *top : m_label_verticals) {
+			if(top->m_vertex.y >= vertex->m_vertex.y) {
+				m_winding_policy.AddPair(label, top->m_winding_weight.label);
+				m_label_verticals[count++] = top;
+			}
+		}
+		m_label_verticals.resize(count);
+		if(vertex->m_loop_prev->m_vertex.x == vertex->m_vertex.x && vertex->m_loop_prev->m_vertex.y > vertex->m_vertex.y)
+			m_label_verticals.push_back(vertex->m_loop_prev);
+		if(vertex->m_loop_next->m_vertex.x == vertex->m_vertex.x && vertex->m_loop_next->m_vertex.y > vertex->m_vertex.y)
+			m_label_verticals.push_back(vertex->m_loop_next);
+
+		// previous vertices at the same position
+		for(size_t i = m_current_vertex; i != 0; ) {
+			SweepVertex *other = m_vertex_queue[--i];
+			if(other->m_vertex.x != vertex->m_vertex.x || other->m_vertex.y != vertex->m_vertex.y)
+				break;
+			m_winding_policy.AddPair(label, other->m_winding_weight.label);
+		}
+
+		// Loops that contain the leftmost vertex of this loop. Every edge between this vertex and the first region
+		// below it with winding number zero is crossed, the loops that were crossed an odd number of times contain it.
+		if(start && m_winding_policy.FirstVertex(label)) {
+			std::vector<size_t> &labels = m_winding_policy.GetLabelBuffer();
+			labels.clear();
+			for(SweepEdge *edge = edge_prev; edge != nullptr && edge->m_winding_number != 0; edge = m_tree.TreePrevious(edge)) {
+				auto it = std::find(labels.begin(), labels.end(), edge->m_winding_weight.label);
+				if(it == labels.end()) {
+					labels.push_back(edge->m_winding_weight.label);
+				} else {
+					*it = labels.back();
+					labels.pop_back();
+				}
+			}
+			for(size_t other : labels) {
+				m_winding_policy.AddPair(label, other);
+			}
+		}
+
+	}
+
 	void ProcessIntersection(SweepEdge *edge, VertexType intersection_vertex) {
 
 		// get surrounding edges
@@ -440,6 +775,22 @@ private:
 		// update winding numbers
 		edge2->m_winding_number = edge1->m_winding_number;
 		edge1->m_winding_number -= edge2->m_winding_weight;
+		ReportLabelCrossing(WindingPolicyHasLabels<WindingPolicy>(), edge1, edge2);
+		// Open paths don't change the winding number, so the output stays where it is. The path is split only when it
+		// crosses an edge that changes the winding number.
+		if(edge1->m_path_segment != INDEX_NONE || edge2->m_path_segment != INDEX_NONE) {
+			if(edge2->m_winding_weight != 0)
+				AddPathEvent(edge1, intersection_vertex);
+			if(edge1->m_winding_weight != 0)
+				AddPathEvent(edge2, intersection_vertex);
+			if(m_record_path_crossings && edge1->m_path_segment != INDEX_NONE && edge2->m_path_segment != INDEX_NONE)
+				m_path_crossings.push_back(PathCrossing{edge1->m_path_segment, edge2->m_path_segment, intersection_vertex});
+			if(edge1->m_winding_weight != 0 || edge2->m_winding_weight != 0)
+				AddTouchingPathEvents(intersection_vertex, edge_prev, edge_next);
+			return;
+		}
+		AddTouchingPathEvents(intersection_vertex, edge_prev, edge_next);
+
 		bool w1 = m_winding_policy.Evaluate(edge1->m_winding_number);
 		bool w2 = m_winding_policy.Evaluate(edge2->m_winding_number);
 
@@ -483,6 +834,9 @@ private:
 					if(OutputPolicy::START_NEEDS_PREV_NEXT && w2) {
 						output_edge_prev = FindPrevOutputEdge(edge_prev);
 						output_edge_next = FindNextOutputEdge(edge_next);
+					} else if(OutputPolicy::START_ALWAYS_NEEDS_PREV_NEXT) {
+						output_edge_prev = FindPrevOutputEdgeOrNull(edge_prev);
+						output_edge_next = FindNextOutputEdgeOrNull(edge_next);
 					} else {
 						output_edge_prev = nullptr;
 						output_edge_next = nullptr;
@@ -507,10 +861,12 @@ private:
 		edge1->m_vertex_first = vertex->m_vertex;
 		edge1->m_vertex_last = vertex->m_loop_prev->m_vertex;
 		edge1->m_winding_weight = -vertex->m_winding_weight;
+		edge1->m_path_segment = (vertex->m_path)? size_t(vertex->m_loop_prev - m_vertex_pool.data()) : INDEX_NONE;
 		edge2 = AddSweepEdge();
 		edge2->m_vertex_first = vertex->m_vertex;
 		edge2->m_vertex_last = vertex->m_loop_next->m_vertex;
 		edge2->m_winding_weight = vertex->m_winding_weight;
+		edge2->m_path_segment = (vertex->m_path)? size_t(vertex - m_vertex_pool.data()) : INDEX_NONE;
 
 		// set vertex pointers
 		vertex->m_loop_prev->m_sweep_edge = edge1;
@@ -523,12 +879,12 @@ private:
 		ValueType b_y = vertex->m_loop_prev->m_vertex.y;
 		ValueType c_x = vertex->m_loop_next->m_vertex.x;
 		ValueType c_y = vertex->m_loop_next->m_vertex.y;
-		if(!NumericalEngine<T>::OrientationTest(a_x, a_y, b_x, b_y, c_x, c_y, true)) {
+		if(!OrientationTest(a_x, a_y, b_x, b_y, c_x, c_y, true)) {
 			std::swap(edge1, edge2);
 		}
 
 		// insert edges into tree
-		m_tree.TreeInsertAt(edge1, [vertex](SweepEdge *edge) { return CompareEdgeVertex(edge, vertex); });
+		m_tree.TreeInsertAt(edge1, [this, vertex](SweepEdge *edge) { return CompareEdgeVertex(edge, vertex); });
 		m_tree.TreeInsertAfter(edge2, edge1);
 
 		// update intersections
@@ -540,6 +896,13 @@ private:
 		WindingNumberType winding_number = (edge_prev == nullptr)? 0 : edge_prev->m_winding_number;
 		edge1->m_winding_number = winding_number + edge1->m_winding_weight;
 		edge2->m_winding_number = winding_number;
+		if(vertex->m_path) {
+			AddPathEvent(edge1, vertex->m_vertex);
+			AddPathEvent(edge2, vertex->m_vertex);
+		}
+		ReportLabelVertex(WindingPolicyHasLabels<WindingPolicy>(), vertex, edge_prev, edge_next, true);
+		if(!vertex->m_path)
+			AddTouchingPathEvents(vertex->m_vertex, edge_prev, edge_next);
 
 		// add output vertex
 		bool w1 = m_winding_policy.Evaluate(edge1->m_winding_number), w2 = m_winding_policy.Evaluate(edge2->m_winding_number);
@@ -551,6 +914,9 @@ private:
 			if(OutputPolicy::START_NEEDS_PREV_NEXT && w2) {
 				output_edge_prev = FindPrevOutputEdge(edge_prev);
 				output_edge_next = FindNextOutputEdge(edge_next);
+			} else if(OutputPolicy::START_ALWAYS_NEEDS_PREV_NEXT) {
+				output_edge_prev = FindPrevOutputEdgeOrNull(edge_prev);
+				output_edge_next = FindNextOutputEdgeOrNull(edge_next);
 			} else {
 				output_edge_prev = nullptr;
 				output_edge_next = nullptr;
@@ -583,11 +949,18 @@ private:
 		// update vertex pointers
 		edge->m_vertex_first = vertex->m_vertex;
 		edge->m_vertex_last = vertex_next->m_vertex;
+		if(vertex->m_path) {
+			edge->m_path_segment = size_t(((vertex->m_edge_forward)? vertex : vertex_next) - m_vertex_pool.data());
+			AddPathEvent(edge, vertex->m_vertex);
+		}
 
 		// update intersections
 		SweepEdge *edge_prev = m_tree.TreePrevious(edge), *edge_next = m_tree.TreeNext(edge);
 		UpdateIntersection(edge_prev, edge);
 		UpdateIntersection(edge, edge_next);
+		ReportLabelVertex(WindingPolicyHasLabels<WindingPolicy>(), vertex, edge_prev, edge_next, false);
+		if(!vertex->m_path)
+			AddTouchingPathEvents(vertex->m_vertex, edge_prev, edge_next);
 
 		// update output vertex
 		if(m_output_policy.HasOutputEdge(edge->m_output_edge)) {
@@ -656,6 +1029,9 @@ private:
 		assert(edge1->m_heap_index == INDEX_NONE); // edge1 can't intersect edge2 because they are connected
 		RemoveIntersection(edge2); // theoretically there shouldn't be an intersection, but this is necessary because of rounding errors
 		UpdateIntersection(edge_prev, edge_next);
+		ReportLabelVertex(WindingPolicyHasLabels<WindingPolicy>(), vertex, edge_prev, edge_next, false);
+		if(!vertex->m_path)
+			AddTouchingPathEvents(vertex->m_vertex, edge_prev, edge_next);
 
 		// update output vertices
 		assert(m_output_policy.HasOutputEdge(edge1->m_output_edge) == m_output_policy.HasOutputEdge(edge2->m_output_edge));
@@ -683,14 +1059,77 @@ private:
 
 	}
 
-public:
+	// Handles the first and last vertex of an open path, which have only one edge.
+	void ProcessPathEndVertex(SweepVertex *vertex) {
 
-	SweepEngine(const Polygon<T, WindingWeightType> &polygon, OutputPolicy output_policy = OutputPolicy(), WindingPolicy winding_policy = WindingPolicy())
-		: m_output_policy(std::move(output_policy)), m_winding_policy(std::move(winding_policy)) {
+		// find the segment
+		SweepVertex *first, *other;
+		if(vertex->m_path_last) {
+			first = vertex->m_loop_prev;
+			other = first;
+		} else {
+			first = vertex;
+			other = vertex->m_loop_next;
+		}
 
-		// initialize
-		m_current_vertex = 0;
-		m_sweep_edge_free_list = nullptr;
+		if(CompareVertexVertex(vertex, other)) {
+
+			// add sweep edge
+			SweepEdge *edge = AddSweepEdge();
+			edge->m_vertex_first = vertex->m_vertex;
+			edge->m_vertex_last = other->m_vertex;
+			edge->m_winding_weight = 0;
+			edge->m_path_segment = size_t(first - m_vertex_pool.data());
+			m_output_policy.ClearOutputEdge(edge->m_output_edge);
+			first->m_sweep_edge = edge;
+
+			// insert edge into tree
+			m_tree.TreeInsertAt(edge, [this, vertex](SweepEdge *edge) { return CompareEdgeVertex(edge, vertex); });
+
+			// update intersections
+			SweepEdge *edge_prev = m_tree.TreePrevious(edge), *edge_next = m_tree.TreeNext(edge);
+			UpdateIntersection(edge_prev, edge);
+			UpdateIntersection(edge, edge_next);
+
+			// update winding number
+			edge->m_winding_number = (edge_prev == nullptr)? 0 : edge_prev->m_winding_number;
+			AddPathEvent(edge, vertex->m_vertex);
+			if(m_record_path_contacts)
+				AddPathContacts(vertex->m_vertex, edge->m_path_segment, edge_prev, edge_next);
+
+		} else {
+
+			// remove edge from tree
+			SweepEdge *edge = first->m_sweep_edge;
+			SweepEdge *edge_prev = m_tree.TreePrevious(edge), *edge_next = m_tree.TreeNext(edge);
+			m_tree.TreeRemove(edge);
+
+			// update intersections
+			RemoveIntersection(edge);
+			UpdateIntersection(edge_prev, edge_next);
+
+			// remove sweep edge
+			RemoveSweepEdge(edge);
+			if(m_record_path_contacts)
+				AddPathContacts(vertex->m_vertex, size_t(first - m_vertex_pool.data()), edge_prev, edge_next);
+
+		}
+
+	}
+
+	// Checks whether all edges are horizontal or vertical. Intersections of such edges are exact, so this property is
+	// preserved during the sweep and the cheaper predicates can be used for the whole run.
+	void DetectRectilinear() {
+		m_rectilinear = true;
+		for(const SweepVertex &v : m_vertex_pool) {
+			if(!v.m_path_last && v.m_vertex.x != v.m_loop_next->m_vertex.x && v.m_vertex.y != v.m_loop_next->m_vertex.y) {
+				m_rectilinear = false;
+				break;
+			}
+		}
+	}
+
+	void ImportPolygon(const Polygon<T, WindingWeightType> &polygon) {
 
 		// count the total number of vertices
 		size_t total_vertices = 0;
@@ -732,6 +1171,8 @@ public:
 				// copy vertex properties
 				v->m_vertex = polygon.vertices[index];
 				v->m_winding_weight = winding_weight;
+				v->m_path = false;
+				v->m_path_last = false;
 
 				// add to the loop
 				if(first == nullptr) {
@@ -753,17 +1194,181 @@ public:
 
 		}
 		assert(current == total_vertices);
+		m_paths.clear();
+		m_path_events.clear();
+		m_path_vertical_events.clear();
+		m_path_crossings.clear();
+		m_path_contacts.clear();
+		m_path_end_segments.clear();
+		m_label_verticals.clear();
+		m_path_loop_verticals.clear();
+		m_path_verticals.clear();
+		DetectRectilinear();
+
+		// the vertices are sorted by Process
+		m_vertex_queue_sorted = 0;
+
+	}
+
+public:
+
+	// Interface that allows loop generators to add loops to the engine directly, without building an intermediate
+	// polygon. It has the same functions as Polygon, so a generator can be a template that accepts either one.
+	class LoopSink {
+
+	public:
+		typedef T ValueType;
+		typedef Vertex<T> VertexType;
+		typedef typename WindingPolicy::WindingWeightType WindingWeightType;
+
+	private:
+		SweepEngine *m_engine;
+		size_t m_loop_begin;
+
+	public:
+		explicit LoopSink(SweepEngine *engine) : m_engine(engine), m_loop_begin(engine->m_vertex_pool.size()) {}
+
+		void AddVertex(VertexType v) {
+			m_engine->m_vertex_pool.emplace_back();
+			SweepVertex &vertex = m_engine->m_vertex_pool.back();
+			vertex.m_vertex = v;
+			vertex.m_path = false;
+			vertex.m_path_last = false;
+		}
+		void AddLoopEnd(WindingWeightType winding_weight) {
+			std::vector<SweepVertex> &pool = m_engine->m_vertex_pool;
+
+			// ignore loops with less than three vertices
+			if(pool.size() - m_loop_begin < 3) {
+				pool.resize(m_loop_begin);
+				return;
+			}
+
+			// the vertices are linked later because the pool may still be reallocated
+			for(size_t i = m_loop_begin; i < pool.size(); ++i) {
+				pool[i].m_winding_weight = winding_weight;
+			}
+			m_engine->m_loop_ends.push_back(pool.size());
+			m_loop_begin = pool.size();
+
+		}
+
+		// Ends an open path instead of a loop. Open paths don't change the winding number, the pieces inside and
+		// outside the result are returned by PathResult.
+		void AddPathEnd() {
+			std::vector<SweepVertex> &pool = m_engine->m_vertex_pool;
+
+			// remove duplicate vertices
+			size_t end = m_loop_begin;
+			for(size_t i = m_loop_begin; i < pool.size(); ++i) {
+				if(end == m_loop_begin || pool[i].m_vertex.x != pool[end - 1].m_vertex.x || pool[i].m_vertex.y != pool[end - 1].m_vertex.y)
+					pool[end++] = pool[i];
+			}
+			pool.resize(end);
+
+			// ignore paths with less than two vertices
+			if(end - m_loop_begin < 2) {
+				pool.resize(m_loop_begin);
+				return;
+			}
+
+			for(size_t i = m_loop_begin; i < end; ++i) {
+				pool[i].m_winding_weight = 0;
+				pool[i].m_path = true;
+			}
+			pool[end - 1].m_path_last = true;
+			m_engine->m_loop_ends.push_back(end);
+			m_engine->m_paths.push_back(PathRange{m_loop_begin, end});
+			m_loop_begin = end;
+
+		}
+
+	};
+
+private:
+
+	static void ImportPolygonAndPaths(LoopSink &sink, const Polygon<T, WindingWeightType> &polygon, const Polyline<T> &polyline) {
+		for(size_t i = 0; i < polygon.loops.size(); ++i) {
+			const VertexType *vertices = polygon.GetLoopVertices(i);
+			size_t n = polygon.GetLoopVertexCount(i);
+			for(size_t j = 0; j < n; ++j) {
+				sink.AddVertex(vertices[j]);
+			}
+			sink.AddLoopEnd(polygon.loops[i].weight);
+		}
+		for(size_t i = 0; i < polyline.path_ends.size(); ++i) {
+			const VertexType *vertices = polyline.GetPathVertices(i);
+			size_t n = polyline.GetPathVertexCount(i);
+			for(size_t j = 0; j < n; ++j) {
+				sink.AddVertex(vertices[j]);
+			}
+			sink.AddPathEnd();
+		}
+	}
+
+	template<typename LoopGenerator>
+	void ImportGenerated(LoopGenerator &&generator) {
+
+		// generate the loops
+		m_vertex_pool.clear();
+		m_loop_ends.clear();
+		m_paths.clear();
+		m_path_events.clear();
+		m_path_vertical_events.clear();
+		m_path_crossings.clear();
+		m_path_contacts.clear();
+		m_path_end_segments.clear();
+		m_label_verticals.clear();
+		m_path_loop_verticals.clear();
+		m_path_verticals.clear();
+		LoopSink sink(this);
+		generator(sink);
+		m_vertex_pool.resize(m_loop_ends.empty()? 0 : m_loop_ends.back()); // drop an unfinished loop
+
+		// link the loops
+		m_vertex_queue.resize(m_vertex_pool.size());
+		size_t index = 0;
+		for(size_t loop = 0; loop < m_loop_ends.size(); ++loop) {
+			size_t begin = index, end = m_loop_ends[loop];
+			for( ; index < end; ++index) {
+				SweepVertex *v = &m_vertex_pool[index], *next = &m_vertex_pool[(index == end - 1)? begin : index + 1];
+				m_vertex_queue[index] = v;
+				v->m_loop_next = next;
+				v->m_edge_forward = CompareVertexVertex(v, next);
+				next->m_loop_prev = v;
+			}
+		}
+		DetectRectilinear();
 
-		// sort the vertices from top to bottom
-		std::sort(m_vertex_queue.begin(), m_vertex_queue.end(), CompareVertexVertex);
+		// the vertices are sorted by Process
+		m_vertex_queue_sorted = 0;
 
 	}
 
-	template<typename VisualizationCallback = void()>
-	void Process(VisualizationCallback &&visualization_callback = DummyVisualizationCallback) {
+	// Sorts the next part of the vertex queue from top to bottom. The size of each part is at least 'min_batch' and
+	// at least the size of everything that was sorted before, so a sweep that stops early only pays for a full sort of
+	// the vertices it has actually processed, plus a linear partitioning step per part.
+	void SortVertexQueue(size_t min_batch) {
+		size_t begin = m_vertex_queue_sorted, remaining = m_vertex_queue.size() - begin;
+		size_t batch = std::max(min_batch, 3 * begin);
+		if(batch >= remaining) {
+			std::sort(m_vertex_queue.begin() + begin, m_vertex_queue.end(), CompareVertexVertex);
+			m_vertex_queue_sorted = m_vertex_queue.size();
+		} else {
+			std::nth_element(m_vertex_queue.begin() + begin, m_vertex_queue.begin() + begin + batch, m_vertex_queue.end(), CompareVertexVertex);
+			std::sort(m_vertex_queue.begin() + begin, m_vertex_queue.begin() + begin + batch, CompareVertexVertex);
+			m_vertex_queue_sorted = begin + batch;
+		}
+	}
+
+	template<typename VisualizationCallback, typename StopCondition>
+	bool ProcessEvents(VisualizationCallback &&visualization_callback, StopCondition &&stop_condition, size_t sort_batch) {
 
 		// iterate through sorted vertices
+		m_intersection_count = 0;
 		for(m_current_vertex = 0; m_current_vertex < m_vertex_queue.size(); ++m_current_vertex) {
+			if(m_current_vertex == m_vertex_queue_sorted)
+				SortVertexQueue(sort_batch);
 			SweepVertex *v = m_vertex_queue[m_current_vertex];
 
 			// process required intersections
@@ -772,24 +1377,127 @@ public:
 				if(w == nullptr || w->m_heap_vertex.x > NumericalEngine<T>::SingleToDouble(v->m_vertex.x))
 					break;
 				visualization_callback();
-				ProcessIntersection(w, VertexType(NumericalEngine<T>::DoubleToSingle(w->m_heap_vertex.x), NumericalEngine<T>::DoubleToSingle(w->m_heap_vertex.y)));
+				m_event_vertex = VertexType(NumericalEngine<T>::DoubleToSingle(w->m_heap_vertex.x), NumericalEngine<T>::DoubleToSingle(w->m_heap_vertex.y));
+				UpdatePathColumn(m_event_vertex);
+				++m_intersection_count;
+				ProcessIntersection(w, m_event_vertex);
+				if(stop_condition())
+					return true;
 			}
 
 			// process the new vertex
 			visualization_callback();
-			if(v->m_loop_prev->m_edge_forward == v->m_edge_forward) {
+			m_event_vertex = v->m_vertex;
+			UpdatePathColumn(m_event_vertex);
+			if(!m_paths.empty())
+				UpdatePathVerticals(v);
+			if(v->m_path && (v->m_path_last || v->m_loop_prev->m_path_last)) {
+				ProcessPathEndVertex(v);
+			} else if(v->m_loop_prev->m_edge_forward == v->m_edge_forward) {
 				ProcessMiddleVertex(v);
 			} else if(v->m_edge_forward) {
 				ProcessStartVertex(v);
 			} else {
 				ProcessStopVertex(v);
 			}
+			if(v->m_path)
+				AddPathVerticals(v);
+			if(stop_condition())
+				return true;
 
 		}
+		FinishPathVerticals();
+
+		return false;
+	}
+
+public:
+
+	SweepEngine(OutputPolicy output_policy = OutputPolicy(), WindingPolicy winding_policy = WindingPolicy())
+		: m_output_policy(std::move(output_policy)), m_winding_policy(std::move(winding_policy)) {
+
+		// initialize
+		m_vertex_queue_sorted = 0;
+		m_current_vertex = 0;
+		m_intersection_count = 0;
+		m_record_path_crossings = false;
+		m_record_path_contacts = false;
+		m_rectilinear = false;
+		m_sweep_edge_free_list = nullptr;
+
+	}
+
+	SweepEngine(const Polygon<T, WindingWeightType> &polygon, OutputPolicy output_policy = OutputPolicy(), WindingPolicy winding_policy = WindingPolicy())
+		: SweepEngine(std::move(output_policy), std::move(winding_policy)) {
+		ImportPolygon(polygon);
+	}
+
+	// Same as above, but also sweeps the open paths of a polyline. The paths don't affect the result, but they are split
+	// where they enter or leave the result, and the pieces can be retrieved with PathResult.
+	SweepEngine(const Polygon<T, WindingWeightType> &polygon, const Polyline<T> &polyline, OutputPolicy output_policy = OutputPolicy(), WindingPolicy winding_policy = WindingPolicy())
+		: SweepEngine(std::move(output_policy), std::move(winding_policy)) {
+		ImportGenerated([&](LoopSink &sink) { ImportPolygonAndPaths(sink, polygon, polyline); });
+	}
+
+	// Prepares the engine for a new polygon. All memory that was allocated by the previous run (including the output)
+	// is reused, so repeatedly processing polygons of similar size doesn't require any new allocations.
+	// This can only be called after Process has completed.
+	void Reset(const Polygon<T, WindingWeightType> &polygon) {
+		assert(m_tree.TreeFirst() == nullptr);
+		assert(HeapTop() == nullptr);
+		m_current_vertex = 0;
+		m_output_policy.Reset();
+		ImportPolygon(polygon);
+	}
+
+	void Reset(const Polygon<T, WindingWeightType> &polygon, const Polyline<T> &polyline) {
+		assert(m_tree.TreeFirst() == nullptr);
+		assert(HeapTop() == nullptr);
+		m_current_vertex = 0;
+		m_output_policy.Reset();
+		ImportGenerated([&](LoopSink &sink) { ImportPolygonAndPaths(sink, polygon, polyline); });
+	}
+
+	// Same as Reset, but the loops are added by a generator instead of being copied from a polygon. The generator is
+	// called once with a LoopSink, for example:
+	//     engine.ResetGenerated([&](decltype(engine)::LoopSink &sink) { PolylineStrokeLoops(sink, polyline, width); });
+	template<typename LoopGenerator>
+	void ResetGenerated(LoopGenerator &&generator) {
+		assert(m_tree.TreeFirst() == nullptr);
+		assert(HeapTop() == nullptr);
+		m_current_vertex = 0;
+		m_output_policy.Reset();
+		ImportGenerated(std::forward<LoopGenerator>(generator));
+	}
 
+	template<typename VisualizationCallback = void()>
+	void Process(VisualizationCallback &&visualization_callback = DummyVisualizationCallback) {
+		bool stopped = ProcessEvents(visualization_callback, [] { return false; }, m_vertex_queue.size());
+		POLYMATH_UNUSED(stopped);
+		assert(!stopped);
 		assert(m_tree.TreeFirst() == nullptr);
 		assert(HeapTop() == nullptr);
+	}
+
+	// Same as Process, but the stop condition is checked after every vertex and intersection, and the sweep is abandoned
+	// as soon as it returns true. This is useful when only a property of the output is needed, e.g. whether it is
+	// empty. The vertices are sorted incrementally, so stopping early also avoids most of the sorting cost. Returns
+	// whether the sweep was stopped early, in which case the output is incomplete. The engine can still be reset
+	// afterwards.
+	template<typename StopCondition>
+	bool ProcessUntil(StopCondition &&stop_condition) {
+		if(!ProcessEvents(DummyVisualizationCallback, stop_condition, std::max(size_t(VERTEX_SORT_BATCH_SIZE), m_vertex_queue.size() / 32)))
+			return false;
+
+		// remove the remaining edges
+		while(SweepEdge *edge = m_tree.TreeFirst()) {
+			m_tree.TreeRemove(edge);
+			RemoveSweepEdge(edge);
+		}
+		m_heap.clear();
+		m_current_vertex = m_vertex_queue.size();
 
+		return true;
 	}
 
 	Visualization<T> Visualize() {
@@ -830,6 +1538,145 @@ public:
 		return m_output_policy.template Result<WindingWeightType>();
 	}
 
+	void ResultInto(Polygon<T, WindingWeightType> &result) {
+		m_output_policy.template ResultInto<WindingWeightType>(result);
+	}
+
+	// Returns the pieces of the open paths that are inside and outside the result, in the original path order. Pieces
+	// that lie on the boundary of the result count as inside, regardless of the side the result is on.
+	void PathResultInto(Polyline<T> &inside, Polyline<T> &outside) {
+		inside.Clear();
+		outside.Clear();
+
+		// group the events by segment, the events of each segment stay in sweep order
+		std::vector<size_t> segment_begin(m_vertex_pool.size() + 1, 0), order(m_path_events.size());
+		for(size_t i = 0; i < m_path_events.size(); ++i) {
+			++segment_begin[m_path_events[i].m_segment + 1];
+		}
+		for(size_t i = 0; i < m_vertex_pool.size(); ++i) {
+			segment_begin[i + 1] += segment_begin[i];
+		}
+		std::vector<size_t> segment_pos(segment_begin.begin(), segment_begin.end() - 1);
+		for(size_t i = 0; i < m_path_events.size(); ++i) {
+			order[segment_pos[m_path_events[i].m_segment]++] = i;
+		}
+
+		// Events on vertical segments can be out of order, because all intersections at the same X coordinate are
+		// processed before the vertices. Events at the same position stay in the order they were added.
+		for(size_t segment = 0; segment < m_vertex_pool.size(); ++segment) {
+			size_t begin = segment_begin[segment], end = segment_begin[segment + 1];
+			if(end - begin > 1 && m_vertex_pool[segment].m_vertex.x == m_vertex_pool[segment + 1].m_vertex.x) {
+				std::stable_sort(order.begin() + begin, order.begin() + end, [this](size_t a, size_t b) {
+					return m_path_events[a].m_vertex.y < m_path_events[b].m_vertex.y;
+				});
+			}
+		}
+
+		for(const PathRange &path : m_paths) {
+
+			// The path is followed in the original order, each step adds a piece with a known state. A new output path
+			// is started whenever the state changes.
+			Polyline<T> *current = nullptr;
+			VertexType last = m_vertex_pool[path.m_begin].m_vertex;
+			auto Step = [&](VertexType v, bool state) {
+				if(v.x == last.x && v.y == last.y)
+					return;
+				Polyline<T> *target = (state)? &inside : &outside;
+				if(target != current) {
+					if(current != nullptr)
+						current->AddPathEnd();
+					current = target;
+					current->AddVertex(last);
+				}
+				current->AddVertex(v);
+				last = v;
+			};
+
+			for(size_t segment = path.m_begin; segment < path.m_end - 1; ++segment) {
+				size_t begin = segment_begin[segment], end = segment_begin[segment + 1];
+				assert(begin != end);
+				VertexType v = m_vertex_pool[segment + 1].m_vertex;
+				if(m_vertex_pool[segment].m_edge_forward) {
+					// the state applies after each event
+					for(size_t k = begin + 1; k < end; ++k) {
+						Step(m_path_events[order[k]].m_vertex, m_path_events[order[k - 1]].m_inside);
+					}
+					Step(v, m_path_events[order[end - 1]].m_inside);
+				} else {
+					// the events are in reverse order, the state applies before each event
+					for(size_t k = end - 1; k > begin; --k) {
+						Step(m_path_events[order[k]].m_vertex, m_path_events[order[k]].m_inside);
+					}
+					Step(v, m_path_events[order[begin]].m_inside);
+				}
+			}
+			if(current != nullptr)
+				current->AddPathEnd();
+
+		}
+
+	}
+
+	Polyline<T> PathResult(bool inside) {
+		Polyline<T> result_inside, result_outside;
+		PathResultInto(result_inside, result_outside);
+		return (inside)? std::move(result_inside) : std::move(result_outside);
+	}
+
+	// Enables recording of all crossings between two open path segments. This must be set before Process is called.
+	void SetRecordPathCrossings(bool enable) {
+		m_record_path_crossings = enable;
+	}
+
+	const std::vector<PathCrossing>& GetPathCrossings() const {
+		return m_path_crossings;
+	}
+
+	// Enables recording of contacts where the first or last vertex of an open path touches another open path segment,
+	// e.g. a shared end vertex or an end vertex on the interior of another segment. Middle vertices of paths are not
+	// checked, so together with the crossings this only covers every touching or overlapping pair of segments if each
+	// path is a single segment. A pair can be recorded more than once. This must be set before Process is called.
+	void SetRecordPathContacts(bool enable) {
+		m_record_path_contacts = enable;
+	}
+
+	const std::vector<PathCrossing>& GetPathContacts() const {
+		return m_path_contacts;
+	}
+
+	// Converts a segment index (as used by PathCrossing) to the index of the path and the index of the first vertex of
+	// the segment within that path. Paths with less than two distinct vertices are not counted, and duplicate vertices
+	// are not counted either.
+	void GetPathSegment(size_t segment, size_t &path, size_t &vertex) const {
+		auto it = std::upper_bound(m_paths.begin(), m_paths.end(), segment, [](size_t value, const PathRange &range) {
+			return value < range.m_begin;
+		});
+		assert(it != m_paths.begin());
+		--it;
+		assert(segment < it->m_end - 1);
+		path = size_t(it - m_paths.begin());
+		vertex = segment - it->m_begin;
+	}
+
+	OutputPolicy& GetOutputPolicy() {
+		return m_output_policy;
+	}
+
+	WindingPolicy& GetWindingPolicy() {
+		return m_winding_policy;
+	}
+
+	// Returns the number of edge intersections that have been processed so far. Together with ProcessUntil, this can be
+	// used to detect intersections without producing any output.
+	size_t GetIntersectionCount() const {
+		return m_intersection_count;
+	}
+
+	// Returns the position of the last vertex or intersection that was processed.
+	VertexType GetEventVertex() const {
+		return m_event_vertex;
+	}
+
 };
 
 }
@@ -246,6 +246,22 @@ public:
 
 	}
 
+	// Returns the last node for which 'comp' returns true, or nullptr if there is none. The nodes for which 'comp' returns
+	// true must come before all other nodes.
+	template<typename Compare>
+	SweepEdge* TreeFindLast(Compare &&comp) {
+		SweepEdge *current = m_tree_root, *result = nullptr;
+		while(current != nullptr) {
+			if(comp(current)) {
+				result = current;
+				current = current->m_tree_right;
+			} else {
+				current = current->m_tree_left;
+			}
+		}
+		return result;
+	}
+
 	template<typename Compare>
 	void TreeInsertAt(SweepEdge *node, Compare &&comp) {
 		assert(node != nullptr);
@@ -663,6 +679,22 @@ public:
 
 	}
 
+	// Returns the last node for which 'comp' returns true, or nullptr if there is none. The nodes for which 'comp' returns
+	// true must come before all other nodes.
+	template<typename Compare>
+	SweepEdge* TreeFindLast(Compare &&comp) {
+		SweepEdge *current = m_tree_root, *result = nullptr;
+		while(current != nullptr) {
+			if(comp(current)) {
+				result = current;
+				current = current->m_tree_right;
+			} else {
+				current = current->m_tree_left;
+			}
+		}
+		return result;
+	}
+
 	template<typename Compare>
 	void TreeInsertAt(SweepEdge *node, Compare &&comp) {
 		assert(node != nullptr);
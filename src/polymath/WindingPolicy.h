@@ -2,6 +2,10 @@
 
 #include "Common.h"
 
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
 namespace PolyMath {
 
 enum WindingRule {
@@ -72,4 +76,168 @@ public:
 	}
 };
 
+// Same as WindingPolicy_NonZero, but also records whether any region has a winding number other than 0, 1 and -1,
+// i.e. whether it is covered by more than one loop. This is used by PolygonValidate, which gives every loop weight 1
+// or -1 so the winding number counts loops.
+template<typename W = default_winding_t>
+class WindingPolicy_Validate {
+private:
+	bool m_overlap = false;
+public:
+	typedef W WindingNumberType;
+	typedef W WindingWeightType;
+	bool Evaluate(WindingNumberType x) {
+		if(x > 1 || x < -1)
+			m_overlap = true;
+		return (x != 0);
+	}
+	bool HasOverlap() const {
+		return m_overlap;
+	}
+	void ClearOverlap() {
+		m_overlap = false;
+	}
+};
+
+// Winding numbers of two polygons that are swept together. Loops of the first polygon have weights (w, 0) and loops
+// of the second polygon have weights (0, w). A single integer converts to (x, x), so the engine can still initialize and
+// compare it with zero.
+template<typename W = default_winding_t>
+struct WindingPair {
+	W a, b;
+	WindingPair() = default;
+	WindingPair(W x)
+		: a(x), b(x) {}
+	WindingPair(W a, W b)
+		: a(a), b(b) {}
+	WindingPair operator-() const {
+		return WindingPair(-a, -b);
+	}
+	WindingPair operator+(const WindingPair &other) const {
+		return WindingPair(a + other.a, b + other.b);
+	}
+	WindingPair operator-(const WindingPair &other) const {
+		return WindingPair(a - other.a, b - other.b);
+	}
+	WindingPair& operator+=(const WindingPair &other) {
+		a += other.a;
+		b += other.b;
+		return *this;
+	}
+	WindingPair& operator-=(const WindingPair &other) {
+		a -= other.a;
+		b -= other.b;
+		return *this;
+	}
+	bool operator==(const WindingPair &other) const {
+		return (a == other.a && b == other.b);
+	}
+	bool operator!=(const WindingPair &other) const {
+		return (a != other.a || b != other.b);
+	}
+	friend std::ostream& operator<<(std::ostream &stream, const WindingPair &w) {
+		return stream << "(" << w.a << ", " << w.b << ")";
+	}
+};
+
+// Selects the region where both polygons are inside (non-zero winding rule).
+template<typename W = default_winding_t>
+class WindingPolicy_PairBoth {
+public:
+	typedef WindingPair<W> WindingNumberType;
+	typedef WindingPair<W> WindingWeightType;
+	static bool Evaluate(WindingNumberType x) {
+		return (x.a != 0 && x.b != 0);
+	}
+};
+
+// Selects the region where only the second polygon is inside (non-zero winding rule).
+template<typename W = default_winding_t>
+class WindingPolicy_PairSecondOnly {
+public:
+	typedef WindingPair<W> WindingNumberType;
+	typedef WindingPair<W> WindingWeightType;
+	static bool Evaluate(WindingNumberType x) {
+		return (x.a == 0 && x.b != 0);
+	}
+};
+
+// Winding weight with a label, used by WindingPolicy_Labels. The winding number is just the sum of the weights, the
+// label only identifies the loop that an edge belongs to. Comparisons ignore the label, so the engine can still compare
+// the weight with zero.
+template<typename W = default_winding_t>
+struct WindingLabel {
+	W weight;
+	size_t label;
+	WindingLabel() = default;
+	WindingLabel(W weight)
+		: weight(weight), label(INDEX_NONE) {}
+	WindingLabel(W weight, size_t label)
+		: weight(weight), label(label) {}
+	WindingLabel operator-() const {
+		return WindingLabel(-weight, label);
+	}
+	bool operator==(const WindingLabel &other) const {
+		return (weight == other.weight);
+	}
+	bool operator!=(const WindingLabel &other) const {
+		return (weight != other.weight);
+	}
+	friend W operator+(W x, const WindingLabel &w) {
+		return x + w.weight;
+	}
+	friend W& operator-=(W &x, const WindingLabel &w) {
+		return x -= w.weight;
+	}
+	friend std::ostream& operator<<(std::ostream &stream, const WindingLabel &w) {
+		return stream << w.weight << "#" << w.label;
+	}
+};
+
+// Collects the pairs of labels (loops) that overlap or touch, see PolygonOverlapPairs. All loops must be simple and
+// have weight 1 after correcting the orientation, so the winding number is the number of loops that contain a point.
+// This is the only policy that receives the label callbacks of the sweep engine.
+template<typename W = default_winding_t>
+class WindingPolicy_Labels {
+public:
+	typedef W WindingNumberType;
+	typedef WindingLabel<W> WindingWeightType;
+private:
+	std::vector<std::pair<size_t, size_t>> m_pairs;
+	std::vector<bool> m_label_seen;
+	std::vector<size_t> m_labels;
+public:
+	static bool Evaluate(WindingNumberType x) {
+		return (x != 0);
+	}
+	void AddPair(size_t label1, size_t label2) {
+		if(label1 != label2)
+			m_pairs.emplace_back(std::min(label1, label2), std::max(label1, label2));
+	}
+	// Returns true the first time a label is seen, which is the leftmost vertex of the loop.
+	bool FirstVertex(size_t label) {
+		if(label >= m_label_seen.size())
+			m_label_seen.resize(label + 1, false);
+		if(m_label_seen[label])
+			return false;
+		m_label_seen[label] = true;
+		return true;
+	}
+	// Temporary memory for the engine.
+	std::vector<size_t>& GetLabelBuffer() {
+		return m_labels;
+	}
+	// Returns the sorted pairs without duplicates.
+	std::vector<std::pair<size_t, size_t>> GetPairs() {
+		std::sort(m_pairs.begin(), m_pairs.end());
+		m_pairs.erase(std::unique(m_pairs.begin(), m_pairs.end()), m_pairs.end());
+		return m_pairs;
+	}
+};
+
+template<typename WindingPolicy>
+struct WindingPolicyHasLabels : std::false_type {};
+template<typename W>
+struct WindingPolicyHasLabels<WindingPolicy_Labels<W>> : std::true_type {};
+
 }
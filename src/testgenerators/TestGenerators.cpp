@@ -206,4 +206,50 @@ Polygon Star(uint32_t num_points, double angle) {
 	return result;
 }
 
+Polyline Traces(uint64_t seed, uint32_t num_paths, uint32_t num_segments, double segment_length) {
+	assert(num_paths != 0);
+	assert(num_segments != 0);
+
+	// initialize rng
+	std::mt19937_64 rng(seed * SEED_MULT + SEED_ADD);
+	std::uniform_real_distribution<double> dist_coord(-0.95, 0.95);
+	std::uniform_real_distribution<double> dist_length(0.5, 1.5);
+	std::uniform_int_distribution<uint32_t> dist_dir(0, 7);
+	std::uniform_int_distribution<uint32_t> dist_turn(0, 3);
+
+	// generate paths (like PCB traces, all segments are multiples of 45 degrees)
+	Polyline result;
+	for(uint32_t i = 0; i < num_paths; ++i) {
+		double x = dist_coord(rng), y = dist_coord(rng);
+		uint32_t dir = dist_dir(rng);
+		result.AddVertex(Vertex(x, y));
+		for(uint32_t j = 0; j < num_segments; ++j) {
+
+			// usually turn by 45 degrees, sometimes 90 degrees
+			switch(dist_turn(rng)) {
+				case 0: dir = (dir + 1) & 7; break;
+				case 1: dir = (dir + 7) & 7; break;
+				case 2: dir = (dir + ((rng() & 1)? 2 : 6)) & 7; break;
+				default: break;
+			}
+
+			// take a step, turn around at the boundary
+			double angle = M_PI / 4.0 * double(dir), length = segment_length * dist_length(rng);
+			double x2 = x + cos(angle) * length, y2 = y + sin(angle) * length;
+			if(x2 < -0.95 || x2 > 0.95 || y2 < -0.95 || y2 > 0.95) {
+				dir = (dir + 4) & 7;
+				x2 = x - cos(angle) * length;
+				y2 = y - sin(angle) * length;
+			}
+			x = x2;
+			y = y2;
+			result.AddVertex(Vertex(x, y));
+
+		}
+		result.AddPathEnd();
+	}
+
+	return result;
+}
+
 }
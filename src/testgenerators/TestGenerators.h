@@ -23,4 +23,6 @@ Polygon EdgeCases(uint64_t seed, uint32_t num_lines, uint32_t num_polygons, doub
 
 Polygon Star(uint32_t num_points, double angle);
 
+Polyline Traces(uint64_t seed, uint32_t num_paths, uint32_t num_segments, double segment_length);
+
 }
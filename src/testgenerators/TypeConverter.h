@@ -7,6 +7,7 @@ namespace TestGenerators {
 // types used for test generation
 typedef PolyMath::Vertex<double> Vertex;
 typedef PolyMath::Polygon<double> Polygon;
+typedef PolyMath::Polyline<double> Polyline;
 
 // type converter base class
 template<typename T, typename Enable = void> struct TypeConverterBase;
@@ -61,6 +62,7 @@ struct TypeConverter : TypeConverterBase<T> {
 
 	typedef PolyMath::Vertex<T> VertexType;
 	typedef PolyMath::Polygon<T> PolygonType;
+	typedef PolyMath::Polyline<T> PolylineType;
 
 	static VertexType ConvertVertexToType(const Vertex &v) {
 		return VertexType(TypeConverterBase<T>::ConvertValueToType(v.x), TypeConverterBase<T>::ConvertValueToType(v.y));
@@ -84,6 +86,16 @@ struct TypeConverter : TypeConverterBase<T> {
 		return output;
 	}
 
+	static PolylineType ConvertPolylineToType(const Polyline &input) {
+		PolylineType output;
+		output.vertices.resize(input.vertices.size());
+		for(size_t i = 0; i < input.vertices.size(); ++i) {
+			output.vertices[i] = ConvertVertexToType(input.vertices[i]);
+		}
+		output.path_ends = input.path_ends;
+		return output;
+	}
+
 	static Polygon ConvertPolygonFromType(const PolygonType &input) {
 		Polygon output;
 		output.vertices.resize(input.vertices.size());
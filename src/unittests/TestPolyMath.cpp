@@ -0,0 +1,1724 @@
+/*
+Copyright (C) 2016  The AlterPCB team
+Contact: Maarten Baert <maarten-baert@hotmail.com>
+
+This file is part of AlterPCB.
+
+AlterPCB is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+AlterPCB is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this AlterPCB.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "polymath/PolyMath.h"
+
+#include "3rdparty/catch.hpp"
+
+#include <functional>
+#include <map>
+#include <random>
+#include <tuple>
+
+using namespace PolyMath;
+
+constexpr uint64_t RANDOM_SEED = UINT64_C(0x3c1f5e7a90d2b846);
+
+template<typename T>
+Polygon<T> MakeRectangle(T x1, T y1, T x2, T y2) {
+	Polygon<T> result;
+	result.AddVertex(Vertex<T>(x1, y1));
+	result.AddVertex(Vertex<T>(x1, y2));
+	result.AddVertex(Vertex<T>(x2, y2));
+	result.AddVertex(Vertex<T>(x2, y1));
+	result.AddLoopEnd(1);
+	return result;
+}
+
+// A comb with n teeth pointing left, the teeth get longer going up. Every tooth starts a new loop in the sweep, and
+// they are all joined at the spine, which produces deep trees in the union-find structures of the output policies.
+Polygon<int32_t> MakeComb(int32_t n) {
+	Polygon<int32_t> result;
+	result.AddVertex(Vertex<int32_t>(1, 0));
+	result.AddVertex(Vertex<int32_t>(1, 2 * n - 1));
+	for(int32_t i = n; i-- > 0; ) {
+		result.AddVertex(Vertex<int32_t>(0, 2 * i + 1));
+		result.AddVertex(Vertex<int32_t>(-(i + 1), 2 * i + 1));
+		result.AddVertex(Vertex<int32_t>(-(i + 1), 2 * i));
+		result.AddVertex(Vertex<int32_t>(0, 2 * i));
+	}
+	result.AddLoopEnd(1);
+	return result;
+}
+
+TEST_CASE("Polygon measurement", "[polymath]") {
+
+	// the same comb rotated by 180 degrees used to overflow the stack in the recursive union-find
+	Polygon<int32_t> comb = MakeComb(200000);
+	for(Vertex<int32_t> &v : comb.vertices) {
+		v = Vertex<int32_t>(-v.x, -v.y);
+	}
+	SweepEngine<int32_t, OutputPolicy_Measure<int32_t>, WindingPolicy_NonZero<>> engine(comb);
+	engine.Process();
+	REQUIRE(engine.GetOutputPolicy().GetArea() == 2.0 * 200000.0 - 1.0 + 200000.0 * 200001.0 / 2.0);
+	REQUIRE(engine.GetOutputPolicy().GetOuterLoopCount() == 1);
+	REQUIRE(engine.GetOutputPolicy().GetHoleLoopCount() == 0);
+
+	// Random polygons, compared with a direct measurement of the loops of the hierarchy result. Loops are classified by
+	// their depth rather than their orientation, because rounded intersections can produce tiny loops that are
+	// degenerate or even inverted.
+	std::mt19937_64 rng(RANDOM_SEED);
+	uint32_t errors = 0;
+	for(uint32_t test = 0; test < 100; ++test) {
+		Polygon<int32_t> polygon;
+		for(uint32_t i = 0; i < 30; ++i) {
+			polygon.AddVertex(Vertex<int32_t>(int32_t(rng() % 1000), int32_t(rng() % 1000)));
+		}
+		polygon.AddLoopEnd(1);
+		SweepEngine<int32_t, OutputPolicy_Hierarchy<int32_t>, WindingPolicy_NonZero<>> hierarchy(polygon);
+		hierarchy.Process();
+		std::vector<size_t> loop_parents;
+		Polygon<int32_t> result = hierarchy.GetOutputPolicy().Result<default_winding_t>(loop_parents);
+		double area = 0.0, perimeter = 0.0, moment_x = 0.0, moment_y = 0.0;
+		size_t outer_loops = 0, hole_loops = 0;
+		std::vector<size_t> depths(result.loops.size());
+		for(size_t i = 0; i < result.loops.size(); ++i) {
+			const Vertex<int32_t> *vertices = result.GetLoopVertices(i);
+			size_t n = result.GetLoopVertexCount(i);
+			for(size_t j = 0; j < n; ++j) {
+				Vertex<double> a(vertices[j].x, vertices[j].y), b(vertices[(j + 1) % n].x, vertices[(j + 1) % n].y);
+				double cross = a.y * b.x - a.x * b.y;
+				area += 0.5 * cross;
+				perimeter += std::hypot(b.x - a.x, b.y - a.y);
+				moment_x += (a.x + b.x) * cross / 6.0;
+				moment_y += (a.y + b.y) * cross / 6.0;
+			}
+			depths[i] = (loop_parents[i] == INDEX_NONE)? 0 : depths[loop_parents[i]] + 1;
+			outer_loops += (depths[i] % 2 == 0);
+			hole_loops += (depths[i] % 2 == 1);
+		}
+		SweepEngine<int32_t, OutputPolicy_Measure<int32_t>, WindingPolicy_NonZero<>> measure(polygon);
+		measure.Process();
+		const OutputPolicy_Measure<int32_t> &policy = measure.GetOutputPolicy();
+		errors += (policy.GetArea() != area);
+		errors += (std::fabs(policy.GetPerimeter() - perimeter) > 1e-9 * perimeter);
+		errors += (std::fabs(policy.GetCentroid().x - moment_x / area) > 1e-9);
+		errors += (std::fabs(policy.GetCentroid().y - moment_y / area) > 1e-9);
+		errors += (policy.GetLoopCount() != result.loops.size());
+		errors += (policy.GetOuterLoopCount() != outer_loops);
+		errors += (policy.GetHoleLoopCount() != hole_loops);
+	}
+	REQUIRE(errors == 0);
+
+}
+
+TEST_CASE("Polygon hierarchy", "[polymath]") {
+
+	// a large comb used to overflow the stack in the recursive union-find
+	Polygon<int32_t> comb = MakeComb(200000);
+	SweepEngine<int32_t, OutputPolicy_Hierarchy<int32_t>, WindingPolicy_NonZero<>> engine(comb);
+	engine.Process();
+	std::vector<size_t> loop_parents;
+	Polygon<int32_t> result = engine.GetOutputPolicy().Result<default_winding_t>(loop_parents);
+	REQUIRE(result.loops.size() == 1);
+	REQUIRE(result.vertices.size() == comb.vertices.size());
+	REQUIRE(loop_parents == std::vector<size_t>{INDEX_NONE});
+
+	// nested loops: an island with a hole inside the hole of a ring, a second island in the same hole and a separate square
+	Polygon<int32_t> nested;
+	auto AddRectangle = [&](int32_t x1, int32_t y1, int32_t x2, int32_t y2, bool hole) {
+		Polygon<int32_t> rect = (hole)? MakeRectangle<int32_t>(x2, y1, x1, y2) : MakeRectangle<int32_t>(x1, y1, x2, y2);
+		for(Vertex<int32_t> v : rect.vertices) {
+			nested.AddVertex(v);
+		}
+		nested.AddLoopEnd(1);
+	};
+	AddRectangle(0, 0, 100, 100, false);
+	AddRectangle(10, 10, 90, 90, true);
+	AddRectangle(20, 20, 40, 40, false);
+	AddRectangle(25, 25, 35, 35, true);
+	AddRectangle(60, 60, 80, 80, false);
+	AddRectangle(200, 0, 300, 100, false);
+	typedef std::pair<int32_t, int32_t> Corner;
+	std::map<Corner, Corner> expected_parents = {
+		{Corner(0, 0), Corner(-1, -1)},
+		{Corner(10, 10), Corner(0, 0)},
+		{Corner(20, 20), Corner(10, 10)},
+		{Corner(25, 25), Corner(20, 20)},
+		{Corner(60, 60), Corner(10, 10)},
+		{Corner(200, 0), Corner(-1, -1)},
+	};
+	SweepEngine<int32_t, OutputPolicy_Hierarchy<int32_t>, WindingPolicy_NonZero<>> engine2(nested);
+	engine2.Process();
+	Polygon<int32_t> tree;
+	std::vector<size_t> tree_parents;
+	engine2.GetOutputPolicy().ResultInto<default_winding_t>(tree, tree_parents);
+	REQUIRE(tree.loops.size() == 6);
+	REQUIRE(tree_parents.size() == 6);
+	auto LoopMin = [&](size_t i) {
+		const Vertex<int32_t> *vertices = tree.GetLoopVertices(i);
+		Corner low(vertices[0].x, vertices[0].y);
+		for(size_t j = 1; j < tree.GetLoopVertexCount(i); ++j) {
+			low = std::min(low, Corner(vertices[j].x, vertices[j].y));
+		}
+		return low;
+	};
+	for(size_t i = 0; i < tree.loops.size(); ++i) {
+		Corner low = LoopMin(i);
+		REQUIRE(expected_parents.count(low) == 1);
+		if(tree_parents[i] == INDEX_NONE) {
+			REQUIRE(expected_parents[low] == Corner(-1, -1));
+		} else {
+			REQUIRE(tree_parents[i] < i);
+			REQUIRE(expected_parents[low] == LoopMin(tree_parents[i]));
+		}
+	}
+
+	// the result can be extracted again into the same containers
+	Polygon<int32_t> tree2 = tree;
+	std::vector<size_t> tree_parents2 = tree_parents;
+	engine2.GetOutputPolicy().ResultInto<default_winding_t>(tree2, tree_parents2);
+	REQUIRE(tree2.vertices.size() == tree.vertices.size());
+	REQUIRE(tree2.loops.size() == tree.loops.size());
+	for(size_t i = 0; i < tree.vertices.size(); ++i) {
+		REQUIRE(tree2.vertices[i].x == tree.vertices[i].x);
+		REQUIRE(tree2.vertices[i].y == tree.vertices[i].y);
+	}
+	REQUIRE(tree_parents2 == tree_parents);
+
+}
+
+TEST_CASE("Half-edge mesh", "[polymath]") {
+	typedef Vertex<int32_t> V;
+
+	// Every half-edge must be consistent with its twin, next and previous half-edges, every face must be bounded by
+	// exactly the half-edges that reference it, and the twin of a filled face must be unfilled. The filled faces must
+	// have the same area as the polygon.
+	auto Check = [](const Polygon<int32_t> &polygon) {
+		typedef SweepEngine<int32_t, OutputPolicy_HalfEdge<int32_t>, WindingPolicy_NonZero<>> Engine;
+		Engine engine(polygon);
+		engine.Process();
+		HalfEdgeMesh<int32_t> mesh = engine.GetOutputPolicy().ResultMesh();
+		SweepEngine<int32_t, OutputPolicy_Measure<int32_t>, WindingPolicy_NonZero<>> measure(polygon);
+		measure.Process();
+		uint32_t errors = 0;
+		for(size_t i = 0; i < mesh.vertices.size(); ++i) {
+			errors += (mesh.half_edges[mesh.vertices[i].half_edge].origin != i);
+		}
+		int64_t area2 = 0;
+		for(size_t i = 0; i < mesh.half_edges.size(); ++i) {
+			const HalfEdgeMesh<int32_t>::HalfEdge &edge = mesh.half_edges[i];
+			errors += (mesh.half_edges[edge.twin].twin != i || edge.twin == i);
+			errors += (mesh.half_edges[edge.next].prev != i || mesh.half_edges[edge.prev].next != i);
+			errors += (mesh.half_edges[edge.next].origin != mesh.GetDestination(i));
+			errors += (mesh.half_edges[edge.next].face != edge.face);
+			errors += (mesh.faces[edge.face].filled == mesh.faces[mesh.GetOppositeFace(i)].filled);
+			if(mesh.faces[edge.face].filled) {
+				V a = mesh.vertices[edge.origin].position, b = mesh.vertices[mesh.GetDestination(i)].position;
+				area2 += int64_t(a.x) * int64_t(b.y) - int64_t(a.y) * int64_t(b.x);
+			}
+		}
+		errors += (0.5 * double(std::abs(area2)) != measure.GetOutputPolicy().GetArea());
+		std::vector<size_t> face_edges(mesh.faces.size(), 0);
+		for(size_t i = 0; i < mesh.half_edges.size(); ++i) {
+			++face_edges[mesh.half_edges[i].face];
+		}
+		errors += (mesh.faces.empty() || mesh.faces[0].outer_half_edge != INDEX_NONE || mesh.faces[0].filled);
+		for(size_t f = 0; f < mesh.faces.size(); ++f) {
+			std::vector<size_t> components(mesh.GetFaceInnerHalfEdges(f), mesh.GetFaceInnerHalfEdges(f) + mesh.GetFaceInnerCount(f));
+			if(mesh.faces[f].outer_half_edge != INDEX_NONE)
+				components.push_back(mesh.faces[f].outer_half_edge);
+			size_t total = 0;
+			for(size_t first : components) {
+				size_t i = first;
+				do {
+					errors += (mesh.half_edges[i].face != f);
+					++total;
+					i = mesh.half_edges[i].next;
+				} while(i != first && total <= mesh.half_edges.size());
+			}
+			errors += (total != face_edges[f]);
+		}
+		return errors;
+	};
+
+	// random polygons with rounded intersections
+	std::mt19937_64 rng(RANDOM_SEED);
+	uint32_t errors = 0;
+	for(uint32_t test = 0; test < 100; ++test) {
+		Polygon<int32_t> polygon;
+		for(uint32_t i = 0; i < 30; ++i) {
+			polygon.AddVertex(V(int32_t(rng() % 1000), int32_t(rng() % 1000)));
+		}
+		polygon.AddLoopEnd(1);
+		errors += Check(polygon);
+	}
+	REQUIRE(errors == 0);
+
+	// a face with two holes, one of which contains an island
+	Polygon<int32_t> polygon = MakeRectangle<int32_t>(0, 0, 100, 100);
+	for(V v : {V(10, 10), V(40, 10), V(40, 90), V(10, 90)}) {
+		polygon.AddVertex(v);
+	}
+	polygon.AddLoopEnd(1);
+	for(V v : {V(60, 10), V(90, 10), V(90, 90), V(60, 90)}) {
+		polygon.AddVertex(v);
+	}
+	polygon.AddLoopEnd(1);
+	for(V v : MakeRectangle<int32_t>(20, 20, 30, 30).vertices) {
+		polygon.AddVertex(v);
+	}
+	polygon.AddLoopEnd(1);
+	REQUIRE(Check(polygon) == 0);
+	SweepEngine<int32_t, OutputPolicy_HalfEdge<int32_t>, WindingPolicy_NonZero<>> engine(polygon);
+	engine.Process();
+	HalfEdgeMesh<int32_t> mesh = engine.GetOutputPolicy().ResultMesh();
+	REQUIRE(mesh.faces.size() == 5);
+	size_t filled = 0, two_holes = 0;
+	for(size_t f = 0; f < mesh.faces.size(); ++f) {
+		filled += mesh.faces[f].filled;
+		two_holes += (mesh.faces[f].filled && mesh.GetFaceInnerCount(f) == 2);
+	}
+	REQUIRE(filled == 2);
+	REQUIRE(two_holes == 1);
+
+}
+
+TEST_CASE("Polygon overlap and containment", "[polymath]") {
+	Polygon<int32_t> a = MakeRectangle<int32_t>(0, 0, 1000, 1000);
+
+	// equal polygons and shared edges
+	REQUIRE(PolygonContains(a, a));
+	REQUIRE(PolygonContains(a, MakeRectangle<int32_t>(0, 0, 500, 500)));
+	REQUIRE(PolygonContains(a, MakeRectangle<int32_t>(200, 0, 500, 500)));
+	REQUIRE(PolygonContains(a, MakeRectangle<int32_t>(200, 500, 1000, 1000)));
+	REQUIRE(PolygonContains(a, MakeRectangle<int32_t>(200, 100, 500, 500)));
+	REQUIRE(!PolygonContains(a, MakeRectangle<int32_t>(200, 100, 1500, 500)));
+	REQUIRE(!PolygonContains(a, MakeRectangle<int32_t>(-1, 0, 1000, 1000)));
+	REQUIRE(PolygonsOverlap(a, a));
+
+	// polygons that only touch
+	REQUIRE(!PolygonsOverlap(a, MakeRectangle<int32_t>(1000, 0, 2000, 1000)));
+	REQUIRE(!PolygonsOverlap(a, MakeRectangle<int32_t>(0, 1000, 1000, 2000)));
+	REQUIRE(!PolygonsOverlap(a, MakeRectangle<int32_t>(200, -500, 500, 0)));
+	REQUIRE(!PolygonsOverlap(a, MakeRectangle<int32_t>(1000, 1000, 2000, 2000)));
+	REQUIRE(PolygonsOverlap(a, MakeRectangle<int32_t>(999, 999, 2000, 2000)));
+
+	// holes
+	Polygon<int32_t> ring = a;
+	ring.AddVertex(Vertex<int32_t>(250, 250));
+	ring.AddVertex(Vertex<int32_t>(750, 250));
+	ring.AddVertex(Vertex<int32_t>(750, 750));
+	ring.AddVertex(Vertex<int32_t>(250, 750));
+	ring.AddLoopEnd(1);
+	REQUIRE(!PolygonsOverlap(ring, MakeRectangle<int32_t>(250, 250, 750, 750)));
+	REQUIRE(!PolygonContains(ring, MakeRectangle<int32_t>(250, 250, 750, 750)));
+	REQUIRE(PolygonContains(ring, MakeRectangle<int32_t>(0, 0, 250, 1000)));
+	REQUIRE(PolygonContains(a, ring));
+	REQUIRE(!PolygonContains(ring, a));
+
+	// floating point
+	Polygon<double> b = MakeRectangle<double>(0.0, 0.0, 1.0, 1.0);
+	REQUIRE(PolygonContains(b, b));
+	REQUIRE(PolygonContains(b, MakeRectangle<double>(0.25, 0.0, 0.5, 0.5)));
+	REQUIRE(!PolygonsOverlap(b, MakeRectangle<double>(0.25, 1.0, 0.5, 1.5)));
+}
+
+template<typename T>
+Polyline<T> MakePath(std::initializer_list<Vertex<T>> vertices) {
+	Polyline<T> result;
+	for(const Vertex<T> &v : vertices) {
+		result.AddVertex(v);
+	}
+	result.AddPathEnd();
+	return result;
+}
+
+template<typename T>
+bool SamePolyline(const Polyline<T> &a, const Polyline<T> &b) {
+	if(a.vertices.size() != b.vertices.size() || a.path_ends != b.path_ends)
+		return false;
+	for(size_t i = 0; i < a.vertices.size(); ++i) {
+		if(a.vertices[i].x != b.vertices[i].x || a.vertices[i].y != b.vertices[i].y)
+			return false;
+	}
+	return true;
+}
+
+template<typename T>
+bool SamePolygon(const Polygon<T> &a, const Polygon<T> &b) {
+	if(a.vertices.size() != b.vertices.size() || a.loops.size() != b.loops.size())
+		return false;
+	for(size_t i = 0; i < a.vertices.size(); ++i) {
+		if(a.vertices[i].x != b.vertices[i].x || a.vertices[i].y != b.vertices[i].y)
+			return false;
+	}
+	for(size_t i = 0; i < a.loops.size(); ++i) {
+		if(a.loops[i].end != b.loops[i].end || a.loops[i].weight != b.loops[i].weight)
+			return false;
+	}
+	return true;
+}
+
+TEST_CASE("Engine reuse", "[polymath]") {
+	typedef Vertex<int32_t> V;
+
+	// A single engine that is reset for every input, with the results written into the same containers, must produce
+	// exactly the same output as a fresh engine for every input. The inputs have different sizes so the reused memory
+	// is sometimes too large and sometimes too small.
+	std::mt19937_64 rng(RANDOM_SEED);
+	SweepEngine<int32_t, OutputPolicy_Simple<int32_t>, WindingPolicy_NonZero<>> engine;
+	SweepEngine<int32_t, OutputPolicy_Hierarchy<int32_t>, WindingPolicy_NonZero<>> engine_hierarchy;
+	Polygon<int32_t> result, result_hierarchy;
+	std::vector<size_t> loop_parents;
+	Polyline<int32_t> inside, outside;
+	uint32_t errors = 0;
+	for(uint32_t test = 0; test < 100; ++test) {
+		Polygon<int32_t> polygon;
+		Polyline<int32_t> polyline;
+		uint32_t n = 3 + uint32_t(rng() % 50);
+		for(uint32_t i = 0; i < n; ++i) {
+			polygon.AddVertex(V(int32_t(rng() % 1000), int32_t(rng() % 1000)));
+			polyline.AddVertex(V(int32_t(rng() % 1000), int32_t(rng() % 1000)));
+		}
+		polygon.AddLoopEnd(1);
+		polyline.AddPathEnd();
+
+		engine.Reset(polygon);
+		engine.Process();
+		engine.ResultInto(result);
+		SweepEngine<int32_t, OutputPolicy_Simple<int32_t>, WindingPolicy_NonZero<>> fresh(polygon);
+		fresh.Process();
+		errors += !SamePolygon(result, fresh.Result());
+
+		engine_hierarchy.Reset(polygon);
+		engine_hierarchy.Process();
+		engine_hierarchy.GetOutputPolicy().ResultInto<default_winding_t>(result_hierarchy, loop_parents);
+		SweepEngine<int32_t, OutputPolicy_Hierarchy<int32_t>, WindingPolicy_NonZero<>> fresh_hierarchy(polygon);
+		fresh_hierarchy.Process();
+		std::vector<size_t> fresh_parents;
+		errors += !SamePolygon(result_hierarchy, fresh_hierarchy.GetOutputPolicy().Result<default_winding_t>(fresh_parents));
+		errors += (loop_parents != fresh_parents);
+
+		engine.Reset(polygon, polyline);
+		engine.Process();
+		engine.PathResultInto(inside, outside);
+		SweepEngine<int32_t, OutputPolicy_Simple<int32_t>, WindingPolicy_NonZero<>> fresh_path(polygon, polyline);
+		fresh_path.Process();
+		Polyline<int32_t> fresh_inside, fresh_outside;
+		fresh_path.PathResultInto(fresh_inside, fresh_outside);
+		errors += !SamePolyline(inside, fresh_inside);
+		errors += !SamePolyline(outside, fresh_outside);
+	}
+	REQUIRE(errors == 0);
+
+}
+
+// Processes a polygon with a tee of two output policies, and with each policy alone.
+template<typename OutputPolicy1, typename OutputPolicy2>
+bool SameTeeResults(const Polygon<int32_t> &polygon) {
+	typedef OutputPolicy_Tee<OutputPolicy1, OutputPolicy2> Tee;
+	SweepEngine<int32_t, Tee, WindingPolicy_NonZero<>> tee(polygon);
+	tee.Process();
+	SweepEngine<int32_t, OutputPolicy1, WindingPolicy_NonZero<>> engine1(polygon);
+	engine1.Process();
+	SweepEngine<int32_t, OutputPolicy2, WindingPolicy_NonZero<>> engine2(polygon);
+	engine2.Process();
+	return SamePolygon(tee.GetOutputPolicy().GetOutputPolicy1().template Result<default_winding_t>(), engine1.Result()) &&
+			SamePolygon(tee.GetOutputPolicy().GetOutputPolicy2().template Result<default_winding_t>(), engine2.Result());
+}
+
+TEST_CASE("Output policy tee", "[polymath]") {
+	typedef Vertex<int32_t> V;
+
+	// Both policies of a tee must produce exactly the same output as when they are used alone, including policies that
+	// need the previous and next edges.
+	std::mt19937_64 rng(RANDOM_SEED);
+	uint32_t errors = 0;
+	for(uint32_t test = 0; test < 100; ++test) {
+		Polygon<int32_t> polygon;
+		for(uint32_t i = 0; i < 30; ++i) {
+			polygon.AddVertex(V(int32_t(rng() % 1000), int32_t(rng() % 1000)));
+		}
+		polygon.AddLoopEnd(1);
+		errors += !SameTeeResults<OutputPolicy_Simple<int32_t>, OutputPolicy_Keyhole<int32_t>>(polygon);
+		errors += !SameTeeResults<OutputPolicy_Triangles<int32_t>, OutputPolicy_Hierarchy<int32_t>>(polygon);
+		errors += !SameTeeResults<OutputPolicy_Monotone<int32_t>, OutputPolicy_Trapezoids<int32_t>>(polygon);
+
+		typedef OutputPolicy_Tee<OutputPolicy_Simple<int32_t>, OutputPolicy_Measure<int32_t>> Tee;
+		SweepEngine<int32_t, Tee, WindingPolicy_NonZero<>> tee(polygon);
+		tee.Process();
+		SweepEngine<int32_t, OutputPolicy_Measure<int32_t>, WindingPolicy_NonZero<>> measure(polygon);
+		measure.Process();
+		errors += (tee.GetOutputPolicy().GetOutputPolicy2().GetArea() != measure.GetOutputPolicy().GetArea());
+		errors += (tee.GetOutputPolicy().GetOutputPolicy2().GetPerimeter() != measure.GetOutputPolicy().GetPerimeter());
+		errors += (tee.GetOutputPolicy().GetOutputPolicy2().GetLoopCount() != measure.GetOutputPolicy().GetLoopCount());
+	}
+	REQUIRE(errors == 0);
+
+}
+
+TEST_CASE("Collinear vertex removal", "[polymath]") {
+	typedef Vertex<int32_t> V;
+
+	auto Area2 = [](const V *vertices, size_t n) {
+		int64_t area2 = 0;
+		for(size_t j = 0; j < n; ++j) {
+			V a = vertices[j], b = vertices[(j == n - 1)? 0 : j + 1];
+			area2 += int64_t(a.x) * int64_t(b.y) - int64_t(a.y) * int64_t(b.x);
+		}
+		return area2;
+	};
+	auto PolygonArea2 = [&](const Polygon<int32_t> &polygon) {
+		int64_t area2 = 0;
+		for(size_t i = 0; i < polygon.loops.size(); ++i) {
+			area2 += Area2(polygon.GetLoopVertices(i), polygon.GetLoopVertexCount(i));
+		}
+		return area2;
+	};
+
+	// Returns the number of loops that still contain duplicate or collinear vertices. Loops without area are skipped,
+	// touching input edges can produce those and they consist of nothing but spikes.
+	auto CountRedundant = [&](const Polygon<int32_t> &polygon) {
+		uint32_t errors = 0;
+		for(size_t i = 0; i < polygon.loops.size(); ++i) {
+			const V *vertices = polygon.GetLoopVertices(i);
+			size_t n = polygon.GetLoopVertexCount(i);
+			if(Area2(vertices, n) == 0)
+				continue;
+			bool redundant = false;
+			for(size_t j = 0; j < n && !redundant; ++j) {
+				V a = vertices[(j == 0)? n - 1 : j - 1], b = vertices[j], c = vertices[(j == n - 1)? 0 : j + 1];
+				redundant = ((a.x == b.x && a.y == b.y) || OutputVertexIsRedundant(a, b, c));
+			}
+			errors += redundant;
+		}
+		return errors;
+	};
+
+	// Random rectangles on a coarse grid with extra vertices on their edges (some of them duplicates) produce many
+	// collinear edges and duplicate intersections. The result must not contain any redundant vertices, and the area
+	// and loop structure must not change.
+	std::mt19937_64 rng(RANDOM_SEED);
+	uint32_t errors = 0, removed = 0;
+	for(uint32_t test = 0; test < 200; ++test) {
+		Polygon<int32_t> polygon;
+		for(uint32_t i = 0; i < 10; ++i) {
+			int32_t x1 = int32_t(rng() % 20), y1 = int32_t(rng() % 20), x2 = x1 + 1 + int32_t(rng() % 10), y2 = y1 + 1 + int32_t(rng() % 10);
+			int32_t xm = x1 + int32_t(rng() % uint32_t(x2 - x1 + 1)), ym = y1 + int32_t(rng() % uint32_t(y2 - y1 + 1));
+			for(V v : {V(x1, y1), V(x1, ym), V(x1, y2), V(xm, y2), V(x2, y2), V(x2, y2), V(x2, ym), V(x2, y1), V(xm, y1)}) {
+				polygon.AddVertex(v);
+			}
+			polygon.AddLoopEnd(1);
+		}
+		SweepEngine<int32_t, OutputPolicy_Simple<int32_t>, WindingPolicy_NonZero<>> engine(polygon);
+		engine.Process();
+		Polygon<int32_t> result = engine.Result();
+		SweepEngine<int32_t, OutputPolicy_Simple<int32_t>, WindingPolicy_NonZero<>> engine_simple(polygon, OutputPolicy_Simple<int32_t>(true));
+		engine_simple.Process();
+		Polygon<int32_t> result_simple = engine_simple.Result();
+		SweepEngine<int32_t, OutputPolicy_Hierarchy<int32_t>, WindingPolicy_NonZero<>> engine_hierarchy(polygon, OutputPolicy_Hierarchy<int32_t>(true));
+		engine_hierarchy.Process();
+		std::vector<size_t> loop_parents;
+		Polygon<int32_t> result_hierarchy = engine_hierarchy.GetOutputPolicy().Result<default_winding_t>(loop_parents);
+		errors += CountRedundant(result_simple) + CountRedundant(result_hierarchy);
+		errors += (result_simple.loops.size() != result.loops.size() || result_hierarchy.loops.size() != result.loops.size());
+		errors += (PolygonArea2(result_simple) != PolygonArea2(result) || PolygonArea2(result_hierarchy) != PolygonArea2(result));
+		removed += uint32_t(result.vertices.size() - result_simple.vertices.size());
+	}
+	REQUIRE(errors == 0);
+	REQUIRE(removed != 0);
+
+	// a square with extra vertices on every edge, duplicate vertices and a duplicate corner
+	Polygon<int32_t> square;
+	for(V v : {V(0, 0), V(0, 3), V(0, 3), V(0, 7), V(0, 10), V(5, 10), V(10, 10), V(10, 10), V(10, 4), V(10, 0), V(6, 0), V(2, 0), V(0, 0)}) {
+		square.AddVertex(v);
+	}
+	square.AddLoopEnd(1);
+	SweepEngine<int32_t, OutputPolicy_Simple<int32_t>, WindingPolicy_NonZero<>> engine(square, OutputPolicy_Simple<int32_t>(true));
+	engine.Process();
+	Polygon<int32_t> result = engine.Result();
+	REQUIRE(result.loops.size() == 1);
+	REQUIRE(result.vertices.size() == 4);
+
+	// a collinear vertex next to a duplicate stop vertex
+	Polygon<int32_t> triangle;
+	for(V v : {V(4, 3), V(4, 3), V(4, 1), V(4, 0), V(0, 0)}) {
+		triangle.AddVertex(v);
+	}
+	triangle.AddLoopEnd(1);
+	engine.Reset(triangle);
+	engine.Process();
+	result = engine.Result();
+	REQUIRE(result.loops.size() == 1);
+	REQUIRE(result.vertices.size() == 3);
+
+}
+
+TEST_CASE("Overlap pairs", "[polymath]") {
+
+	// Random rectangles in both orientations, compared with a brute force check. Rectangles overlap or touch exactly
+	// when their closed ranges overlap in both directions, which includes nested rectangles.
+	struct Rect {
+		int32_t x1, y1, x2, y2;
+	};
+	auto Touch = [](const Rect &a, const Rect &b) {
+		return (a.x1 <= b.x2 && b.x1 <= a.x2 && a.y1 <= b.y2 && b.y1 <= a.y2);
+	};
+	std::mt19937_64 rng(RANDOM_SEED);
+	uint32_t errors = 0;
+	for(uint32_t test = 0; test < 100; ++test) {
+		std::vector<Rect> rects(40);
+		Polygon<int32_t> a, b;
+		for(size_t i = 0; i < rects.size(); ++i) {
+			Rect &r = rects[i];
+			r.x1 = int32_t(rng() % 100);
+			r.y1 = int32_t(rng() % 100);
+			r.x2 = r.x1 + 1 + int32_t(rng() % 20);
+			r.y2 = r.y1 + 1 + int32_t(rng() % 20);
+			Polygon<int32_t> loop = (rng() % 2 == 0)? MakeRectangle<int32_t>(r.x1, r.y1, r.x2, r.y2) : MakeRectangle<int32_t>(r.x2, r.y1, r.x1, r.y2);
+			Polygon<int32_t> &target = (i < rects.size() / 2)? a : b;
+			for(Vertex<int32_t> v : loop.vertices) {
+				target.AddVertex(v);
+			}
+			target.AddLoopEnd((rng() % 2 == 0)? 1 : -1);
+		}
+		Polygon<int32_t> all = a;
+		for(size_t i = 0; i < b.loops.size(); ++i) {
+			for(size_t j = 0; j < b.GetLoopVertexCount(i); ++j) {
+				all.AddVertex(b.GetLoopVertices(i)[j]);
+			}
+			all.AddLoopEnd(b.loops[i].weight);
+		}
+
+		std::vector<std::pair<size_t, size_t>> expected, expected_ab;
+		for(size_t i = 0; i < rects.size(); ++i) {
+			for(size_t j = i + 1; j < rects.size(); ++j) {
+				if(Touch(rects[i], rects[j])) {
+					expected.emplace_back(i, j);
+					if(i < a.loops.size() && j >= a.loops.size())
+						expected_ab.emplace_back(i, j - a.loops.size());
+				}
+			}
+		}
+		std::vector<std::pair<size_t, size_t>> found = PolygonOverlapPairs(all), found_ab = PolygonOverlapPairs(a, b);
+		std::sort(found.begin(), found.end());
+		std::sort(found_ab.begin(), found_ab.end());
+		errors += (found != expected) + (found_ab != expected_ab);
+	}
+	REQUIRE(errors == 0);
+
+	// every loop is treated as a separate polygon, so an island in a hole overlaps with the hole and the outer loop
+	Polygon<int32_t> ring = MakeRectangle<int32_t>(0, 0, 100, 100);
+	for(Vertex<int32_t> v : MakeRectangle<int32_t>(90, 10, 10, 90).vertices) {
+		ring.AddVertex(v);
+	}
+	ring.AddLoopEnd(1);
+	for(Vertex<int32_t> v : MakeRectangle<int32_t>(40, 40, 60, 60).vertices) {
+		ring.AddVertex(v);
+	}
+	ring.AddLoopEnd(1);
+	std::vector<std::pair<size_t, size_t>> pairs = PolygonOverlapPairs(ring);
+	std::sort(pairs.begin(), pairs.end());
+	REQUIRE(pairs == (std::vector<std::pair<size_t, size_t>>{{0, 1}, {0, 2}, {1, 2}}));
+
+}
+
+TEST_CASE("Clearance violations", "[polymath]") {
+
+	// Random rectangles compared with a brute force check. The distance between two axis-aligned edges is the distance
+	// between their bounding boxes. A clearance that isn't the square root of an integer avoids ties.
+	struct Box {
+		double x1, y1, x2, y2;
+	};
+	auto BoxDistance = [](const Box &a, const Box &b) {
+		return std::hypot(std::max(0.0, std::max(a.x1 - b.x2, b.x1 - a.x2)), std::max(0.0, std::max(a.y1 - b.y2, b.y1 - a.y2)));
+	};
+	auto LoopDistance = [&](const Polygon<int32_t> &polygon, size_t loop1, size_t loop2) {
+		double best = std::numeric_limits<double>::infinity();
+		for(size_t i = 0; i < 4; ++i) {
+			for(size_t j = 0; j < 4; ++j) {
+				Vertex<int32_t> a1 = polygon.GetLoopVertices(loop1)[i], a2 = polygon.GetLoopVertices(loop1)[(i + 1) % 4];
+				Vertex<int32_t> b1 = polygon.GetLoopVertices(loop2)[j], b2 = polygon.GetLoopVertices(loop2)[(j + 1) % 4];
+				Box a = {double(std::min(a1.x, a2.x)), double(std::min(a1.y, a2.y)), double(std::max(a1.x, a2.x)), double(std::max(a1.y, a2.y))};
+				Box b = {double(std::min(b1.x, b2.x)), double(std::min(b1.y, b2.y)), double(std::max(b1.x, b2.x)), double(std::max(b1.y, b2.y))};
+				best = std::min(best, BoxDistance(a, b));
+			}
+		}
+		return best;
+	};
+	std::mt19937_64 rng(RANDOM_SEED);
+	const double clearance = 3.5;
+	uint32_t errors = 0;
+	for(uint32_t test = 0; test < 100; ++test) {
+		Polygon<int32_t> polygon, a, b;
+		for(size_t i = 0; i < 40; ++i) {
+			int32_t x1 = int32_t(rng() % 100), y1 = int32_t(rng() % 100);
+			Polygon<int32_t> loop = MakeRectangle<int32_t>(x1, y1, x1 + 1 + int32_t(rng() % 20), y1 + 1 + int32_t(rng() % 20));
+			for(Vertex<int32_t> v : loop.vertices) {
+				polygon.AddVertex(v);
+				((i < 20)? a : b).AddVertex(v);
+			}
+			polygon.AddLoopEnd(1);
+			((i < 20)? a : b).AddLoopEnd(1);
+		}
+		std::vector<std::tuple<size_t, size_t, double>> expected, expected_ab;
+		for(size_t i = 0; i < polygon.loops.size(); ++i) {
+			for(size_t j = i + 1; j < polygon.loops.size(); ++j) {
+				double distance = LoopDistance(polygon, i, j);
+				if(distance < clearance) {
+					expected.emplace_back(i, j, distance);
+					if(i < a.loops.size() && j >= a.loops.size())
+						expected_ab.emplace_back(i, j - a.loops.size(), distance);
+				}
+			}
+		}
+		auto Check = [&](const std::vector<ClearanceViolation> &violations, const std::vector<std::tuple<size_t, size_t, double>> &expected) {
+			uint32_t errors = (violations.size() != expected.size());
+			for(size_t k = 0; k < violations.size() && k < expected.size(); ++k) {
+				const ClearanceViolation &v = violations[k];
+				errors += (v.loop1 != std::get<0>(expected[k]) || v.loop2 != std::get<1>(expected[k]));
+				errors += (std::fabs(v.distance - std::get<2>(expected[k])) > 1e-9);
+				errors += (std::fabs(std::hypot(v.point2.x - v.point1.x, v.point2.y - v.point1.y) - v.distance) > 1e-9);
+			}
+			return errors;
+		};
+		std::vector<ClearanceViolation> violations = PolygonClearance(polygon, clearance);
+		std::vector<ClearanceViolation> violations_ab = PolygonClearance(a, b, clearance);
+		auto Order = [](const ClearanceViolation &p, const ClearanceViolation &q) {
+			return std::make_pair(p.loop1, p.loop2) < std::make_pair(q.loop1, q.loop2);
+		};
+		std::sort(violations.begin(), violations.end(), Order);
+		std::sort(violations_ab.begin(), violations_ab.end(), Order);
+		errors += Check(violations, expected) + Check(violations_ab, expected_ab);
+	}
+	REQUIRE(errors == 0);
+
+}
+
+TEST_CASE("Polyline clipping", "[polymath]") {
+	typedef Vertex<int32_t> V;
+	Polygon<int32_t> square = MakeRectangle<int32_t>(0, 0, 10, 10);
+
+	// crossing the boundary
+	Polyline<int32_t> path = MakePath<int32_t>({V(-5, 5), V(5, 5), V(5, 15)});
+	REQUIRE(SamePolyline(PolylineClip_NonZero(path, square, true), MakePath<int32_t>({V(0, 5), V(5, 5), V(5, 10)})));
+	Polyline<int32_t> outside = PolylineClip_NonZero(path, square, false);
+	REQUIRE(outside.path_ends.size() == 2);
+
+	// paths on the boundary are inside, on every side and in both directions
+	Polyline<int32_t> edges[] = {
+		MakePath<int32_t>({V(2, 0), V(8, 0)}), MakePath<int32_t>({V(8, 0), V(2, 0)}),
+		MakePath<int32_t>({V(2, 10), V(8, 10)}), MakePath<int32_t>({V(8, 10), V(2, 10)}),
+		MakePath<int32_t>({V(0, 2), V(0, 8)}), MakePath<int32_t>({V(0, 8), V(0, 2)}),
+		MakePath<int32_t>({V(10, 2), V(10, 8)}), MakePath<int32_t>({V(10, 8), V(10, 2)}),
+	};
+	for(const Polyline<int32_t> &edge : edges) {
+		REQUIRE(SamePolyline(PolylineClip_NonZero(edge, square, true), edge));
+		REQUIRE(PolylineClip_NonZero(edge, square, false).vertices.empty());
+	}
+
+	// paths that follow part of the boundary are split at the corners
+	REQUIRE(SamePolyline(PolylineClip_NonZero(MakePath<int32_t>({V(-5, 0), V(15, 0)}), square, true), MakePath<int32_t>({V(0, 0), V(10, 0)})));
+	REQUIRE(SamePolyline(PolylineClip_NonZero(MakePath<int32_t>({V(10, 15), V(10, -5)}), square, true), MakePath<int32_t>({V(10, 10), V(10, 0)})));
+	REQUIRE(SamePolyline(PolylineClip_NonZero(MakePath<int32_t>({V(10, 5), V(10, 15)}), square, true), MakePath<int32_t>({V(10, 5), V(10, 10)})));
+
+	// diagonal boundaries, with the polygon on either side
+	Polygon<int32_t> lower, upper;
+	lower.AddVertex(V(0, 0));
+	lower.AddVertex(V(10, 10));
+	lower.AddVertex(V(10, 0));
+	lower.AddLoopEnd(1);
+	upper.AddVertex(V(0, 0));
+	upper.AddVertex(V(0, 10));
+	upper.AddVertex(V(10, 10));
+	upper.AddLoopEnd(1);
+	Polyline<int32_t> diagonal = MakePath<int32_t>({V(-2, -2), V(12, 12)});
+	REQUIRE(SamePolyline(PolylineClip_NonZero(diagonal, lower, true), MakePath<int32_t>({V(0, 0), V(10, 10)})));
+	REQUIRE(SamePolyline(PolylineClip_NonZero(diagonal, upper, true), MakePath<int32_t>({V(0, 0), V(10, 10)})));
+
+	// random polygons on a small grid and paths with many vertical pieces, every piece is checked at its midpoint
+	std::mt19937_64 rng(RANDOM_SEED);
+	for(size_t test = 0; test < 1000; ++test) {
+		Polygon<double> polygon;
+		for(size_t loop = 0; loop < 2; ++loop) {
+			for(size_t i = 0; i < 8; ++i) {
+				polygon.AddVertex(Vertex<double>(double(rng() % 8), double(rng() % 8)));
+			}
+			polygon.AddLoopEnd(1);
+		}
+		Polyline<double> polyline;
+		for(size_t i = 0; i < 10; ++i) {
+			Vertex<double> v(double(rng() % 8), double(rng() % 8));
+			if(i != 0 && rng() % 2 == 0)
+				v.x = polyline.vertices.back().x;
+			polyline.AddVertex(v);
+		}
+		polyline.AddPathEnd();
+		for(bool inside : {true, false}) {
+			Polyline<double> result = PolylineClip_NonZero(polyline, polygon, inside);
+			for(size_t i = 0; i < result.path_ends.size(); ++i) {
+				for(size_t j = (i == 0)? 0 : result.path_ends[i - 1]; j + 1 < result.path_ends[i]; ++j) {
+					Vertex<double> a = result.vertices[j], b = result.vertices[j + 1];
+					Vertex<double> mid((a.x + b.x) * 0.5, (a.y + b.y) * 0.5), closest;
+					double distance = 1.0;
+					for(size_t loop = 0; loop < polygon.loops.size(); ++loop) {
+						const Vertex<double> *vertices = polygon.GetLoopVertices(loop);
+						size_t n = polygon.GetLoopVertexCount(loop);
+						for(size_t k = 0; k < n; ++k) {
+							distance = std::min(distance, SegmentPointDistance2(vertices[k], vertices[(k + 1) % n], mid, closest));
+						}
+					}
+					if(distance < 1e-12)
+						continue;
+					REQUIRE((PolygonPointWindingNumber(polygon, mid) != 0) == inside);
+				}
+			}
+		}
+	}
+}
+
+TEST_CASE("Polygon validation", "[polymath]") {
+	typedef Vertex<int32_t> V;
+	std::vector<ValidationIssue<int32_t>> issues;
+
+	// simple loops, touching loops and holes are valid
+	Polygon<int32_t> square = MakeRectangle<int32_t>(0, 0, 10, 10);
+	REQUIRE(PolygonValidate(square));
+	Polygon<int32_t> touching = square;
+	touching.AddVertex(V(10, 0));
+	touching.AddVertex(V(10, 10));
+	touching.AddVertex(V(20, 10));
+	touching.AddVertex(V(20, 0));
+	touching.AddLoopEnd(1);
+	REQUIRE(PolygonValidate(touching));
+	Polygon<int32_t> ring = square;
+	ring.AddVertex(V(2, 2));
+	ring.AddVertex(V(8, 2));
+	ring.AddVertex(V(8, 8));
+	ring.AddVertex(V(2, 8));
+	ring.AddLoopEnd(1);
+	REQUIRE(PolygonValidate(ring));
+
+	// only the sign of the weight matters
+	Polygon<int32_t> heavy;
+	heavy.AddVertex(V(0, 0));
+	heavy.AddVertex(V(0, 10));
+	heavy.AddVertex(V(10, 10));
+	heavy.AddVertex(V(10, 0));
+	heavy.AddLoopEnd(2);
+	REQUIRE(PolygonValidate(heavy));
+	heavy.AddVertex(V(0, 0));
+	heavy.AddVertex(V(0, 10));
+	heavy.AddVertex(V(10, 10));
+	heavy.AddVertex(V(10, 0));
+	heavy.AddLoopEnd(0);
+	REQUIRE(PolygonValidate(heavy));
+
+	// duplicate vertices and an explicit closing vertex don't create intersections
+	Polygon<int32_t> closed;
+	closed.AddVertex(V(10, 2));
+	closed.AddVertex(V(12, 12));
+	closed.AddVertex(V(11, 0));
+	closed.AddVertex(V(10, 2));
+	closed.AddLoopEnd(1);
+	REQUIRE(PolygonValidate(closed));
+	Polygon<int32_t> duplicates;
+	duplicates.AddVertex(V(0, 0));
+	duplicates.AddVertex(V(0, 0));
+	duplicates.AddVertex(V(0, 10));
+	duplicates.AddVertex(V(10, 10));
+	duplicates.AddVertex(V(10, 10));
+	duplicates.AddVertex(V(10, 10));
+	duplicates.AddVertex(V(10, 0));
+	duplicates.AddVertex(V(0, 0));
+	duplicates.AddLoopEnd(1);
+	REQUIRE(PolygonValidate(duplicates));
+	duplicates.AddVertex(V(5, 5));
+	duplicates.AddVertex(V(5, 15));
+	duplicates.AddVertex(V(5, 15));
+	duplicates.AddVertex(V(15, 15));
+	duplicates.AddVertex(V(15, 5));
+	duplicates.AddVertex(V(5, 5));
+	duplicates.AddLoopEnd(1);
+	REQUIRE(!PolygonValidate(duplicates, issues, 10));
+	REQUIRE(std::count_if(issues.begin(), issues.end(), [](const ValidationIssue<int32_t> &issue) {
+		return issue.type == VALIDATIONISSUE_INTERSECTION;
+	}) == 2);
+
+	// overlapping loops
+	Polygon<int32_t> overlap = square;
+	overlap.AddVertex(V(5, 5));
+	overlap.AddVertex(V(5, 15));
+	overlap.AddVertex(V(15, 15));
+	overlap.AddVertex(V(15, 5));
+	overlap.AddLoopEnd(1);
+	REQUIRE(!PolygonValidate(overlap, issues, 10));
+	REQUIRE(std::count_if(issues.begin(), issues.end(), [](const ValidationIssue<int32_t> &issue) {
+		return issue.type == VALIDATIONISSUE_OVERLAP;
+	}) != 0);
+	REQUIRE(std::count_if(issues.begin(), issues.end(), [](const ValidationIssue<int32_t> &issue) {
+		return issue.type == VALIDATIONISSUE_INTERSECTION;
+	}) == 2);
+
+	// self-intersecting loop
+	Polygon<int32_t> bowtie;
+	bowtie.AddVertex(V(0, 0));
+	bowtie.AddVertex(V(10, 10));
+	bowtie.AddVertex(V(10, 0));
+	bowtie.AddVertex(V(0, 10));
+	bowtie.AddLoopEnd(1);
+	REQUIRE(!PolygonValidate(bowtie, issues, 10));
+	REQUIRE(issues.size() == 1);
+	REQUIRE(issues[0].type == VALIDATIONISSUE_INTERSECTION);
+	REQUIRE(issues[0].vertex.x == 5);
+	REQUIRE(issues[0].vertex.y == 5);
+}
+
+TEST_CASE("Segment intersections", "[polymath]") {
+	typedef Vertex<int32_t> V;
+	typedef std::pair<V, V> Segment;
+
+	// touching and collinear segments are not reported
+	std::vector<Segment> fixed = {
+		Segment(V(0, 0), V(10, 10)), Segment(V(0, 10), V(10, 0)), // crossing at (5, 5)
+		Segment(V(10, 10), V(20, 0)), // shares an endpoint with the first segment
+		Segment(V(15, 5), V(15, 20)), // endpoint on the previous segment
+		Segment(V(2, 2), V(8, 8)), // collinear with the first segment
+		Segment(V(3, 3), V(3, 3)), // zero length
+	};
+	std::vector<SegmentIntersection<int32_t>> result = SegmentIntersections(fixed);
+	REQUIRE(result.size() == 2);
+	std::sort(result.begin(), result.end(), [](const SegmentIntersection<int32_t> &a, const SegmentIntersection<int32_t> &b) {
+		return std::make_pair(a.segment1, a.segment2) < std::make_pair(b.segment1, b.segment2);
+	});
+	REQUIRE(result[0].segment1 == 0);
+	REQUIRE(result[0].segment2 == 1);
+	REQUIRE(result[0].vertex.x == 5);
+	REQUIRE(result[0].vertex.y == 5);
+	REQUIRE(result[1].segment1 == 1);
+	REQUIRE(result[1].segment2 == 4);
+
+	// touching segments are reported once per pair if requested, at an endpoint that lies on the other segment
+	result = SegmentIntersections(fixed, true);
+	std::sort(result.begin(), result.end(), [](const SegmentIntersection<int32_t> &a, const SegmentIntersection<int32_t> &b) {
+		return std::make_pair(a.segment1, a.segment2) < std::make_pair(b.segment1, b.segment2);
+	});
+	REQUIRE(result.size() == 5);
+	REQUIRE((result[1].segment1 == 0 && result[1].segment2 == 2 && result[1].vertex.x == 10 && result[1].vertex.y == 10));
+	REQUIRE((result[2].segment1 == 0 && result[2].segment2 == 4));
+	REQUIRE((result[4].segment1 == 2 && result[4].segment2 == 3 && result[4].vertex.x == 15 && result[4].vertex.y == 5));
+
+	// compare with a brute force test
+	std::mt19937_64 rng(RANDOM_SEED);
+	auto Orientation = [](V a, V b, V c) {
+		int64_t d = int64_t(b.x - a.x) * int64_t(c.y - a.y) - int64_t(b.y - a.y) * int64_t(c.x - a.x);
+		return (d > 0) - (d < 0);
+	};
+	uint32_t errors = 0;
+	for(uint32_t test = 0; test < 100; ++test) {
+		std::vector<Segment> segments(50);
+		for(Segment &segment : segments) {
+			segment.first = V(int32_t(rng() % 100), int32_t(rng() % 100));
+			segment.second = V(int32_t(rng() % 100), int32_t(rng() % 100));
+		}
+		std::vector<std::pair<size_t, size_t>> expected, found;
+		for(size_t i = 0; i < segments.size(); ++i) {
+			for(size_t j = i + 1; j < segments.size(); ++j) {
+				const Segment &s1 = segments[i], &s2 = segments[j];
+				if(Orientation(s1.first, s1.second, s2.first) * Orientation(s1.first, s1.second, s2.second) < 0 &&
+						Orientation(s2.first, s2.second, s1.first) * Orientation(s2.first, s2.second, s1.second) < 0)
+					expected.emplace_back(i, j);
+			}
+		}
+		for(const SegmentIntersection<int32_t> &intersection : SegmentIntersections(segments)) {
+			found.emplace_back(intersection.segment1, intersection.segment2);
+		}
+		std::sort(found.begin(), found.end());
+		errors += (found != expected);
+	}
+	REQUIRE(errors == 0);
+
+	// a small grid produces many touching and collinear segments
+	auto Between = [](V a, V b, V c) {
+		return std::min(a.x, b.x) <= c.x && c.x <= std::max(a.x, b.x) && std::min(a.y, b.y) <= c.y && c.y <= std::max(a.y, b.y);
+	};
+	for(uint32_t test = 0; test < 100; ++test) {
+		std::vector<Segment> segments(30);
+		for(Segment &segment : segments) {
+			segment.first = V(int32_t(rng() % 8), int32_t(rng() % 8));
+			segment.second = V(int32_t(rng() % 8), int32_t(rng() % 8));
+		}
+		std::vector<std::pair<size_t, size_t>> expected, found;
+		for(size_t i = 0; i < segments.size(); ++i) {
+			for(size_t j = i + 1; j < segments.size(); ++j) {
+				const Segment &s1 = segments[i], &s2 = segments[j];
+				if((s1.first.x == s1.second.x && s1.first.y == s1.second.y) || (s2.first.x == s2.second.x && s2.first.y == s2.second.y))
+					continue;
+				int o1 = Orientation(s1.first, s1.second, s2.first), o2 = Orientation(s1.first, s1.second, s2.second);
+				int o3 = Orientation(s2.first, s2.second, s1.first), o4 = Orientation(s2.first, s2.second, s1.second);
+				if((o1 * o2 < 0 && o3 * o4 < 0) || (o1 == 0 && Between(s1.first, s1.second, s2.first)) ||
+						(o2 == 0 && Between(s1.first, s1.second, s2.second)) || (o3 == 0 && Between(s2.first, s2.second, s1.first)) ||
+						(o4 == 0 && Between(s2.first, s2.second, s1.second)))
+					expected.emplace_back(i, j);
+			}
+		}
+		for(const SegmentIntersection<int32_t> &intersection : SegmentIntersections(segments, true)) {
+			found.emplace_back(intersection.segment1, intersection.segment2);
+		}
+		std::sort(found.begin(), found.end());
+		errors += (found != expected);
+	}
+	REQUIRE(errors == 0);
+}
+
+TEST_CASE("Constrained Delaunay triangulation", "[polymath]") {
+	typedef Vertex<int32_t> V;
+
+	// Every edge between two triangles must be locally Delaunay: the opposite vertex of one triangle can't be inside the
+	// circumcircle of the other one, unless the edge can't be flipped because the quadrilateral isn't convex. The
+	// remaining edges are the constraints, including edges that are used more than once in the same direction (rounded
+	// intersections can produce those). The area must not change.
+	auto Check = [](const Polygon<int32_t> &polygon) {
+		typedef SweepEngine<int32_t, OutputPolicy_Triangles<int32_t>, WindingPolicy_NonZero<>> Engine;
+		Engine engine(OutputPolicy_Triangles<int32_t>(true));
+		engine.Reset(polygon);
+		engine.Process();
+		Polygon<int32_t> result = engine.Result();
+		SweepEngine<int32_t, OutputPolicy_Measure<int32_t>, WindingPolicy_NonZero<>> measure(polygon);
+		measure.Process();
+		auto Key = [](V a, V b) {
+			return std::make_pair((int64_t(a.x) << 32) | uint32_t(a.y), (int64_t(b.x) << 32) | uint32_t(b.y));
+		};
+		std::map<std::pair<int64_t, int64_t>, V> opposite;
+		std::map<std::pair<int64_t, int64_t>, size_t> count;
+		int64_t area2 = 0;
+		for(size_t i = 0; i < result.loops.size(); ++i) {
+			const V *v = result.GetLoopVertices(i);
+			area2 += int64_t(v[1].x - v[0].x) * int64_t(v[2].y - v[0].y) - int64_t(v[1].y - v[0].y) * int64_t(v[2].x - v[0].x);
+			for(size_t k = 0; k < 3; ++k) {
+				opposite[Key(v[k], v[(k + 1) % 3])] = v[(k + 2) % 3];
+				++count[Key(v[k], v[(k + 1) % 3])];
+			}
+		}
+		uint32_t errors = (0.5 * double(area2) != measure.GetOutputPolicy().GetArea());
+		for(size_t i = 0; i < result.loops.size(); ++i) {
+			const V *v = result.GetLoopVertices(i);
+			for(size_t k = 0; k < 3; ++k) {
+				V a = v[k], b = v[(k + 1) % 3], c = v[(k + 2) % 3];
+				auto it = opposite.find(Key(b, a));
+				if(it == opposite.end() || count[Key(a, b)] != 1 || count[Key(b, a)] != 1)
+					continue;
+				V d = it->second;
+				errors += (NumericalEngine<int32_t>::InCircleTest(a.x, a.y, b.x, b.y, c.x, c.y, d.x, d.y, true) &&
+						NumericalEngine<int32_t>::OrientationTest(a.x, a.y, d.x, d.y, c.x, c.y, true) &&
+						NumericalEngine<int32_t>::OrientationTest(d.x, d.y, b.x, b.y, c.x, c.y, true));
+			}
+		}
+		return errors;
+	};
+
+	// random polygons with rounded intersections, and a polygon with a hole
+	std::mt19937_64 rng(RANDOM_SEED);
+	uint32_t errors = 0;
+	for(uint32_t test = 0; test < 100; ++test) {
+		Polygon<int32_t> polygon;
+		for(uint32_t i = 0; i < 30; ++i) {
+			polygon.AddVertex(V(int32_t(rng() % 1000), int32_t(rng() % 1000)));
+		}
+		polygon.AddLoopEnd(1);
+		errors += Check(polygon);
+	}
+	Polygon<int32_t> ring = MakeRectangle<int32_t>(0, 0, 100, 30);
+	for(V v : {V(10, 10), V(90, 12), V(90, 20), V(10, 18)}) {
+		ring.AddVertex(v);
+	}
+	ring.AddLoopEnd(1);
+	errors += Check(ring);
+	REQUIRE(errors == 0);
+
+	// the spine of a comb is shared by a fan of triangles, this used to be quadratic
+	REQUIRE(Check(MakeComb(1000)) == 0);
+	Polygon<int32_t> comb = MakeComb(100000);
+	SweepEngine<int32_t, OutputPolicy_Triangles<int32_t>, WindingPolicy_NonZero<>> engine(OutputPolicy_Triangles<int32_t>(true));
+	engine.Reset(comb);
+	engine.Process();
+	REQUIRE(engine.Result().loops.size() == comb.vertices.size() - 2);
+}
+
+TEST_CASE("Trapezoidal decomposition", "[polymath]") {
+
+	// the trapezoids must tile the output exactly, including self-intersecting input with rounded intersections
+	std::mt19937_64 rng(RANDOM_SEED);
+	uint32_t errors = 0;
+	for(uint32_t test = 0; test < 200; ++test) {
+		Polygon<int32_t> polygon;
+		for(uint32_t i = 0; i < 20; ++i) {
+			polygon.AddVertex(Vertex<int32_t>(int32_t(rng() % 2001) - 1000, int32_t(rng() % 2001) - 1000));
+		}
+		polygon.AddLoopEnd(1);
+		SweepEngine<int32_t, OutputPolicy_Trapezoids<int32_t>, WindingPolicy_NonZero<>> engine(polygon);
+		engine.Process();
+		double area = 0.0;
+		for(const auto &t : engine.GetOutputPolicy().ResultTrapezoids()) {
+			area += 0.5 * double(t.x2 - t.x1) * ((t.y1_upper - t.y1_lower) + (t.y2_upper - t.y2_lower));
+		}
+		SweepEngine<int32_t, OutputPolicy_Measure<int32_t>, WindingPolicy_NonZero<>> measure(polygon);
+		measure.Process();
+		errors += (std::fabs(area - measure.GetOutputPolicy().GetArea()) > 1e-6);
+	}
+	REQUIRE(errors == 0);
+
+	// The loops of Result() must also conserve the area. Half of the vertices are placed on earlier edges, so the
+	// interpolated sides of some triangle-shaped trapezoids are inverted by rounding.
+	uint32_t loop_errors = 0;
+	std::uniform_real_distribution<double> coordinate(0.0, 10.0), fraction(0.0, 1.0);
+	for(uint32_t test = 0; test < 500; ++test) {
+		Polygon<double> polygon;
+		for(uint32_t i = 0; i < 20; ++i) {
+			if(i >= 2 && rng() % 2 == 0) {
+				size_t j = rng() % (i - 1);
+				Vertex<double> a = polygon.vertices[j], b = polygon.vertices[j + 1];
+				double t = fraction(rng);
+				polygon.AddVertex(Vertex<double>(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t));
+			} else {
+				polygon.AddVertex(Vertex<double>(coordinate(rng), coordinate(rng)));
+			}
+		}
+		polygon.AddLoopEnd(1);
+		SweepEngine<double, OutputPolicy_Trapezoids<double>, WindingPolicy_NonZero<>> engine(polygon);
+		engine.Process();
+		Polygon<double> result = engine.Result();
+		double area = 0.0;
+		for(size_t i = 0; i < result.loops.size(); ++i) {
+			const Vertex<double> *vertices = result.GetLoopVertices(i);
+			size_t n = result.GetLoopVertexCount(i);
+			for(size_t j = 0; j < n; ++j) {
+				area += 0.5 * (vertices[(j + 1) % n].x * vertices[j].y - vertices[j].x * vertices[(j + 1) % n].y);
+			}
+		}
+		SweepEngine<double, OutputPolicy_Measure<double>, WindingPolicy_NonZero<>> measure(polygon);
+		measure.Process();
+		loop_errors += (std::fabs(area - measure.GetOutputPolicy().GetArea()) > 1e-9);
+	}
+	REQUIRE(loop_errors == 0);
+
+	// a square with a hole is split at the X coordinates of the hole
+	Polygon<int32_t> ring = MakeRectangle<int32_t>(0, 0, 30, 30);
+	ring.AddVertex(Vertex<int32_t>(10, 10));
+	ring.AddVertex(Vertex<int32_t>(20, 10));
+	ring.AddVertex(Vertex<int32_t>(20, 20));
+	ring.AddVertex(Vertex<int32_t>(10, 20));
+	ring.AddLoopEnd(1);
+	SweepEngine<int32_t, OutputPolicy_Trapezoids<int32_t>, WindingPolicy_NonZero<>> engine(ring);
+	engine.Process();
+	REQUIRE(engine.GetOutputPolicy().ResultTrapezoids().size() == 4);
+	Polygon<int32_t> result = engine.Result();
+	REQUIRE(result.loops.size() == 4);
+	REQUIRE(result.vertices.size() == 16);
+
+}
+
+TEST_CASE("Convex partition", "[polymath]") {
+
+	// Small coordinates produce many rounded intersections. The pieces must cover the same area, and merged pieces must
+	// be convex (only single triangles can be inverted by rounding).
+	std::mt19937_64 rng(RANDOM_SEED);
+	uint32_t area_errors = 0, convex_errors = 0;
+	for(uint32_t test = 0; test < 200; ++test) {
+		int32_t range = (test < 100)? 10 : 2001;
+		Polygon<int32_t> polygon;
+		for(uint32_t i = 0; i < 20; ++i) {
+			polygon.AddVertex(Vertex<int32_t>(int32_t(rng() % range), int32_t(rng() % range)));
+		}
+		polygon.AddLoopEnd(1);
+		SweepEngine<int32_t, OutputPolicy_Convex<int32_t>, WindingPolicy_NonZero<>> engine(polygon);
+		engine.Process();
+		Polygon<int32_t> result = engine.Result();
+		int64_t area2 = 0;
+		for(size_t i = 0; i < result.loops.size(); ++i) {
+			const Vertex<int32_t> *vertices = result.GetLoopVertices(i);
+			size_t n = result.GetLoopVertexCount(i);
+			for(size_t j = 0; j < n; ++j) {
+				Vertex<int32_t> a = vertices[j], b = vertices[(j + 1) % n], c = vertices[(j + 2) % n];
+				area2 += int64_t(b.x) * int64_t(a.y) - int64_t(a.x) * int64_t(b.y);
+				int64_t cross = int64_t(b.x - a.x) * int64_t(c.y - b.y) - int64_t(b.y - a.y) * int64_t(c.x - b.x);
+				convex_errors += (n > 3 && cross >= 0);
+			}
+		}
+		SweepEngine<int32_t, OutputPolicy_Measure<int32_t>, WindingPolicy_NonZero<>> measure(polygon);
+		measure.Process();
+		area_errors += (0.5 * double(area2) != measure.GetOutputPolicy().GetArea());
+	}
+	REQUIRE(area_errors == 0);
+	REQUIRE(convex_errors == 0);
+
+	// a square with a hole needs four pieces
+	Polygon<int32_t> ring = MakeRectangle<int32_t>(0, 0, 30, 30);
+	ring.AddVertex(Vertex<int32_t>(10, 10));
+	ring.AddVertex(Vertex<int32_t>(20, 10));
+	ring.AddVertex(Vertex<int32_t>(20, 20));
+	ring.AddVertex(Vertex<int32_t>(10, 20));
+	ring.AddLoopEnd(1);
+	SweepEngine<int32_t, OutputPolicy_Convex<int32_t>, WindingPolicy_NonZero<>> engine(ring);
+	engine.Process();
+	Polygon<int32_t> result = engine.Result();
+	REQUIRE(result.loops.size() == 4);
+
+}
+
+TEST_CASE("Minkowski sum", "[polymath]") {
+	typedef Vertex<int32_t> V;
+	auto GetArea = [](const Polygon<int32_t> &polygon) {
+		SweepEngine<int32_t, OutputPolicy_Measure<int32_t>, WindingPolicy_NonZero<>> engine(polygon);
+		engine.Process();
+		return engine.GetOutputPolicy().GetArea();
+	};
+	Polygon<int32_t> square = MakeRectangle<int32_t>(0, 0, 10, 10);
+
+	// convex kernel
+	REQUIRE(GetArea(PolygonMinkowskiSum(square, MakeRectangle<int32_t>(-1, -1, 1, 1))) == 144.0);
+
+	// non-convex kernels are decomposed into convex pieces, in either orientation
+	Polygon<int32_t> corner;
+	for(V v : {V(0, 0), V(2, 0), V(2, 1), V(1, 1), V(1, 2), V(0, 2)}) {
+		corner.AddVertex(v);
+	}
+	corner.AddLoopEnd(1);
+	REQUIRE(GetArea(PolygonMinkowskiSum(square, corner)) == 143.0);
+	std::reverse(corner.vertices.begin(), corner.vertices.end());
+	REQUIRE(GetArea(PolygonMinkowskiSum(square, corner)) == 143.0);
+
+	// a kernel with a hole, the hole shrinks by the size of the polygon
+	Polygon<int32_t> ring = MakeRectangle<int32_t>(-5, -5, 5, 5);
+	ring.AddVertex(V(-2, -2));
+	ring.AddVertex(V(2, -2));
+	ring.AddVertex(V(2, 2));
+	ring.AddVertex(V(-2, 2));
+	ring.AddLoopEnd(1);
+	Polygon<int32_t> result = PolygonMinkowskiSum(MakeRectangle<int32_t>(0, 0, 1, 1), ring);
+	REQUIRE(GetArea(result) == 112.0);
+	REQUIRE(PolygonPointWindingNumber(result, V(0, 0)) == 0);
+}
+
+// Returns the area of a polygon that was produced by the sweep engine (no overlapping loops).
+template<typename T>
+double GetArea(const Polygon<T> &polygon) {
+	double area = 0.0;
+	for(size_t i = 0; i < polygon.loops.size(); ++i) {
+		const Vertex<T> *vertices = polygon.GetLoopVertices(i);
+		size_t n = polygon.GetLoopVertexCount(i);
+		for(size_t j = 0; j < n; ++j) {
+			Vertex<T> a = vertices[j], b = vertices[(j == n - 1)? 0 : j + 1];
+			area += double(a.y) * double(b.x) - double(a.x) * double(b.y);
+		}
+	}
+	return 0.5 * std::fabs(area);
+}
+
+TEST_CASE("Polyline stroking", "[polymath]") {
+	typedef Vertex<double> V;
+
+	// caps of a single segment
+	Polyline<double> segment = MakePath<double>({V(0.0, 0.0), V(100.0, 0.0)});
+	REQUIRE(GetArea(PolylineStroke(segment, 10.0, OFFSETJOIN_ROUND, STROKECAP_BUTT)) == Approx(1000.0));
+	REQUIRE(GetArea(PolylineStroke(segment, 10.0, OFFSETJOIN_ROUND, STROKECAP_SQUARE)) == Approx(1100.0));
+	REQUIRE(GetArea(PolylineStroke(segment, 10.0, OFFSETJOIN_ROUND, STROKECAP_ROUND)) == Approx(1000.0 + 25.0 * M_PI).epsilon(1e-3));
+
+	// joins of a left turn, the outside of the turn is at the bottom right
+	Polyline<double> corner = MakePath<double>({V(0.0, 0.0), V(100.0, 0.0), V(100.0, 100.0)});
+	REQUIRE(GetArea(PolylineStroke(corner, 10.0, OFFSETJOIN_MITER, STROKECAP_BUTT)) == Approx(2000.0));
+	REQUIRE(GetArea(PolylineStroke(corner, 10.0, OFFSETJOIN_MITER, STROKECAP_BUTT, 1.0)) < 2000.0 - 1.0);
+	REQUIRE(GetArea(PolylineStroke(corner, 10.0, OFFSETJOIN_ROUND, STROKECAP_BUTT)) == Approx(1975.0 + 6.25 * M_PI).epsilon(1e-3));
+
+	// crossing paths are joined, and paths without length are ignored
+	Polyline<double> cross = MakePath<double>({V(0.0, 0.0), V(100.0, 0.0)});
+	cross.AddVertex(V(50.0, -50.0));
+	cross.AddVertex(V(50.0, 50.0));
+	cross.AddPathEnd();
+	cross.AddVertex(V(200.0, 200.0));
+	cross.AddVertex(V(200.0, 200.0));
+	cross.AddPathEnd();
+	Polygon<double> result = PolylineStroke(cross, 10.0, OFFSETJOIN_ROUND, STROKECAP_BUTT);
+	REQUIRE(result.loops.size() == 1);
+	REQUIRE(GetArea(result) == Approx(1900.0));
+
+	// a path that doubles back on itself has no holes
+	Polyline<double> zigzag = MakePath<double>({V(0.0, 0.0), V(100.0, 0.0), V(0.0, 1.0), V(100.0, 2.0)});
+	REQUIRE(PolylineStroke(zigzag, 10.0).loops.size() == 1);
+
+}
+
+TEST_CASE("Curve flattening", "[polymath]") {
+	typedef Vertex<double> V;
+
+	// returns the largest distance between the curve and the segments, sampled within each parameter step
+	auto MaxError = [](const Polyline<double> &polyline, std::function<V(double)> curve) {
+		size_t n = polyline.vertices.size() - 1;
+		double error = 0.0;
+		for(size_t i = 0; i < n; ++i) {
+			V a = polyline.vertices[i], b = polyline.vertices[i + 1];
+			double length = std::hypot(b.x - a.x, b.y - a.y);
+			for(size_t k = 1; k < 16; ++k) {
+				V p = curve((double(i) + double(k) / 16.0) / double(n));
+				error = std::max(error, std::fabs((b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x)) / length);
+			}
+		}
+		return error;
+	};
+
+	// a quarter arc, every vertex must be on the circle and the last one must be the end point
+	Polyline<double> arc;
+	arc.AddVertex(V(100.0, 0.0));
+	FlattenArc(arc, V(100.0, 0.0), V(0.0, 0.0), 0.5 * M_PI, 0.01);
+	arc.AddPathEnd();
+	REQUIRE(arc.vertices.size() > 50);
+	REQUIRE(arc.vertices.size() < 60);
+	for(V v : arc.vertices) {
+		REQUIRE(std::hypot(v.x, v.y) == Approx(100.0));
+	}
+	REQUIRE(arc.vertices.back().x == Approx(0.0).margin(1e-12));
+	REQUIRE(arc.vertices.back().y == Approx(100.0));
+	REQUIRE(MaxError(arc, [](double t) { return V(100.0 * std::cos(0.5 * M_PI * t), 100.0 * std::sin(0.5 * M_PI * t)); }) <= 0.01);
+
+	// clockwise arcs go the other way
+	Polyline<double> arc2;
+	FlattenArc(arc2, V(100.0, 0.0), V(0.0, 0.0), -0.5 * M_PI, 0.01);
+	REQUIRE(arc2.vertices.front().y < 0.0);
+	REQUIRE(arc2.vertices.back().y == Approx(-100.0));
+
+	// Bezier curves
+	V p0(0.0, 0.0), p1(50.0, 100.0), p2(100.0, -50.0), p3(150.0, 0.0);
+	Polyline<double> quadratic;
+	quadratic.AddVertex(p0);
+	FlattenQuadraticBezier(quadratic, p0, p1, p2, 0.01);
+	quadratic.AddPathEnd();
+	REQUIRE(quadratic.vertices.back().x == p2.x);
+	REQUIRE(quadratic.vertices.back().y == p2.y);
+	REQUIRE(MaxError(quadratic, [&](double t) {
+		double u = 1.0 - t;
+		return V(u * u * p0.x + 2.0 * u * t * p1.x + t * t * p2.x, u * u * p0.y + 2.0 * u * t * p1.y + t * t * p2.y);
+	}) <= 0.01);
+	Polyline<double> cubic;
+	cubic.AddVertex(p0);
+	FlattenCubicBezier(cubic, p0, p1, p2, p3, 0.01);
+	cubic.AddPathEnd();
+	REQUIRE(cubic.vertices.back().x == p3.x);
+	REQUIRE(cubic.vertices.back().y == p3.y);
+	REQUIRE(MaxError(cubic, [&](double t) {
+		double u = 1.0 - t;
+		return V(u * u * u * p0.x + 3.0 * u * u * t * p1.x + 3.0 * u * t * t * p2.x + t * t * t * p3.x,
+				u * u * u * p0.y + 3.0 * u * u * t * p1.y + 3.0 * u * t * t * p2.y + t * t * t * p3.y);
+	}) <= 0.01);
+
+	// a circle, the tolerance is limited by the precision of integer vertices
+	Polygon<double> circle;
+	FlattenCircle(circle, V(0.0, 0.0), 100.0, 0.01, 1);
+	REQUIRE(circle.loops.size() == 1);
+	REQUIRE(GetArea(circle) == Approx(M_PI * 10000.0).epsilon(2.0 * M_PI * 100.0 * 0.01 / (M_PI * 10000.0)));
+	Polygon<int32_t> circle_int;
+	FlattenCircle(circle_int, V(0.0, 0.0), 10.0, 1e-6, 1);
+	REQUIRE(circle_int.vertices.size() <= 16);
+
+}
+
+TEST_CASE("Douglas-Peucker reduction", "[polymath]") {
+	typedef Vertex<double> V;
+
+	// returns the distance between a point and the closest edge of a loop
+	auto LoopDistance = [](V p, const V *vertices, size_t n) {
+		double best = std::numeric_limits<double>::infinity();
+		for(size_t j = 0; j < n; ++j) {
+			V a = vertices[j], b = vertices[(j == n - 1)? 0 : j + 1];
+			double dx = b.x - a.x, dy = b.y - a.y, len2 = dx * dx + dy * dy;
+			double t = (len2 > 0.0)? std::max(0.0, std::min(1.0, ((p.x - a.x) * dx + (p.y - a.y) * dy) / len2)) : 0.0;
+			best = std::min(best, std::hypot(p.x - a.x - dx * t, p.y - a.y - dy * t));
+		}
+		return best;
+	};
+
+	// An oversampled circle with some noise. The reduced loop must use original vertices in the original order, and
+	// every original vertex must be within the tolerance of the reduced loop.
+	std::mt19937_64 rng(RANDOM_SEED);
+	std::uniform_real_distribution<double> noise(-0.1, 0.1);
+	Polygon<double> circle;
+	for(size_t i = 0; i < 10000; ++i) {
+		double angle = 2.0 * M_PI * double(i) / 10000.0;
+		circle.AddVertex(V(100.0 * std::cos(angle) + noise(rng), 100.0 * std::sin(angle) + noise(rng)));
+	}
+	circle.AddLoopEnd(1);
+	Polygon<double> reduced = PolygonReduce(circle, 0.5);
+	REQUIRE(reduced.loops.size() == 1);
+	REQUIRE(reduced.loops[0].weight == 1);
+	REQUIRE(reduced.vertices.size() < 200);
+	size_t k = 0;
+	for(size_t i = 0; i < circle.vertices.size() && k < reduced.vertices.size(); ++i) {
+		if(circle.vertices[i].x == reduced.vertices[k].x && circle.vertices[i].y == reduced.vertices[k].y)
+			++k;
+	}
+	REQUIRE(k == reduced.vertices.size());
+	double error = 0.0;
+	for(V v : circle.vertices) {
+		error = std::max(error, LoopDistance(v, reduced.vertices.data(), reduced.vertices.size()));
+	}
+	REQUIRE(error <= 0.5);
+
+	// collinear vertices are removed even with zero tolerance, loops that are too small are dropped
+	Polygon<int32_t> polygon;
+	for(Vertex<int32_t> v : {Vertex<int32_t>(0, 0), Vertex<int32_t>(0, 5), Vertex<int32_t>(0, 10), Vertex<int32_t>(5, 10),
+			Vertex<int32_t>(10, 10), Vertex<int32_t>(10, 0), Vertex<int32_t>(5, 0)}) {
+		polygon.AddVertex(v);
+	}
+	polygon.AddLoopEnd(1);
+	for(Vertex<int32_t> v : {Vertex<int32_t>(20, 0), Vertex<int32_t>(21, 1), Vertex<int32_t>(22, 0)}) {
+		polygon.AddVertex(v);
+	}
+	polygon.AddLoopEnd(-1);
+	Polygon<int32_t> result;
+	PolygonReduceInto(result, polygon, 0.0);
+	REQUIRE(result.loops.size() == 2);
+	REQUIRE(result.GetLoopVertexCount(0) == 4);
+	REQUIRE(result.GetLoopVertexCount(1) == 3);
+	REQUIRE(result.loops[1].weight == -1);
+	PolygonReduceInto(result, polygon, 2.0);
+	REQUIRE(result.loops.size() == 1);
+	REQUIRE(result.GetLoopVertexCount(0) == 4);
+
+}
+
+TEST_CASE("Convex hull", "[polymath]") {
+	typedef Vertex<int32_t> V;
+	auto Cross = [](V a, V b, V c) {
+		return int64_t(b.x - a.x) * int64_t(c.y - a.y) - int64_t(b.y - a.y) * int64_t(c.x - a.x);
+	};
+
+	// Random points with many duplicates. The hull must be a strictly convex clockwise loop of input points, and all
+	// points must be inside or on the hull. Together this can only be true for the actual convex hull. The hull of
+	// the hulls of two halves must be the same.
+	std::mt19937_64 rng(RANDOM_SEED);
+	uint32_t errors = 0;
+	for(uint32_t test = 0; test < 200; ++test) {
+		std::vector<V> points;
+		int32_t range = (test % 2 == 0)? 10 : 1000;
+		for(size_t i = 0; i < 100; ++i) {
+			points.emplace_back(int32_t(rng() % uint32_t(range)), int32_t(rng() % uint32_t(range)));
+		}
+		std::vector<V> hull;
+		ConvexHullInto(hull, points.data(), points.size());
+		size_t n = hull.size();
+		errors += (n < 3);
+		for(size_t j = 0; j < n; ++j) {
+			errors += (Cross(hull[j], hull[(j + 1) % n], hull[(j + 2) % n]) >= 0);
+			errors += (std::find_if(points.begin(), points.end(), [&](V p) { return p.x == hull[j].x && p.y == hull[j].y; }) == points.end());
+			for(V p : points) {
+				errors += (Cross(hull[j], hull[(j + 1) % n], p) > 0);
+			}
+		}
+		std::vector<V> hull1, hull2, combined, hull3;
+		ConvexHullInto(hull1, points.data(), 50);
+		ConvexHullInto(hull2, points.data() + 50, 50);
+		combined = hull1;
+		combined.insert(combined.end(), hull2.begin(), hull2.end());
+		ConvexHullInto(hull3, combined.data(), combined.size());
+		errors += (hull3.size() != n);
+		for(size_t j = 0; j < n && j < hull3.size(); ++j) {
+			errors += (hull3[j].x != hull[j].x || hull3[j].y != hull[j].y);
+		}
+	}
+	REQUIRE(errors == 0);
+
+	// collinear points and duplicates
+	std::vector<V> line = {V(0, 0), V(5, 5), V(2, 2), V(5, 5), V(-3, -3)}, hull;
+	ConvexHullInto(hull, line.data(), line.size());
+	REQUIRE(hull.size() < 3);
+	Polygon<int32_t> polygon;
+	for(V v : line) {
+		polygon.AddVertex(v);
+	}
+	polygon.AddLoopEnd(1);
+	REQUIRE(PolygonConvexHull(polygon).loops.empty());
+	REQUIRE(PolygonConvexHull(polygon).vertices.empty());
+	std::vector<V> square = {V(0, 0), V(10, 10), V(10, 0), V(0, 10), V(5, 0), V(10, 10), V(5, 5), V(0, 0)};
+	ConvexHullInto(hull, square.data(), square.size());
+	REQUIRE(hull.size() == 4);
+
+}
+
+TEST_CASE("Rectilinear predicates", "[polymath]") {
+	typedef Vertex<int32_t> V;
+
+	// The rectilinear predicates must give the same results as the general ones for every pair of horizontal or
+	// vertical edges on a small grid, including touching and overlapping edges. Edges go from left to right (bottom to
+	// top for vertical edges), like in the sweep engine.
+	std::mt19937_64 rng(RANDOM_SEED);
+	auto RandomEdge = [&](V &first, V &last) {
+		first = V(int32_t(rng() % 6), int32_t(rng() % 6));
+		last = first;
+		int32_t length = 1 + int32_t(rng() % 4);
+		if(rng() % 2 == 0) {
+			last.x += length;
+		} else {
+			last.y += length;
+		}
+	};
+	uint32_t errors = 0, intersections = 0;
+	for(uint32_t test = 0; test < 100000; ++test) {
+		V a1, a2, b1, b2;
+		RandomEdge(a1, a2);
+		RandomEdge(b1, b2);
+		for(bool strict : {false, true}) {
+			errors += (NumericalEngine_Rectilinear<int32_t>::OrientationTest(a1.x, a1.y, a2.x, a2.y, b1.x, b1.y, strict) !=
+					NumericalEngine<int32_t>::OrientationTest(a1.x, a1.y, a2.x, a2.y, b1.x, b1.y, strict));
+		}
+		if(a1.x > b2.x || b1.x > a2.x)
+			continue;
+		int64_t res1_x = 0, res1_y = 0, res2_x = 0, res2_y = 0;
+		bool intersect1 = NumericalEngine_Rectilinear<int32_t>::IntersectionTest(a1.x, a1.y, a2.x, a2.y, b1.x, b1.y, b2.x, b2.y, res1_x, res1_y);
+		bool intersect2 = NumericalEngine<int32_t>::IntersectionTest(a1.x, a1.y, a2.x, a2.y, b1.x, b1.y, b2.x, b2.y, res2_x, res2_y);
+		errors += (intersect1 != intersect2);
+		if(intersect1 && intersect2) {
+			errors += (res1_x != res2_x || res1_y != res2_y);
+			++intersections;
+		}
+	}
+	REQUIRE(errors == 0);
+	REQUIRE(intersections != 0);
+
+	// Unions of random rectangles compared with the number of covered grid cells. The same input in floating point
+	// must give exactly the same result, and a single diagonal edge must switch back to the general predicates.
+	for(uint32_t test = 0; test < 100; ++test) {
+		Polygon<int32_t> polygon;
+		std::vector<uint8_t> cells(40 * 40, 0);
+		for(uint32_t i = 0; i < 20; ++i) {
+			int32_t x1 = int32_t(rng() % 30), y1 = int32_t(rng() % 30), x2 = x1 + 1 + int32_t(rng() % 10), y2 = y1 + 1 + int32_t(rng() % 10);
+			bool reverse = (rng() % 2 == 0);
+			Polygon<int32_t> loop = (reverse)? MakeRectangle<int32_t>(x2, y1, x1, y2) : MakeRectangle<int32_t>(x1, y1, x2, y2);
+			for(V v : loop.vertices) {
+				polygon.AddVertex(v);
+			}
+			polygon.AddLoopEnd((reverse)? -1 : 1);
+			for(int32_t y = y1; y < y2; ++y) {
+				for(int32_t x = x1; x < x2; ++x) {
+					cells[size_t(y * 40 + x)] = 1;
+				}
+			}
+		}
+		double covered = double(std::count(cells.begin(), cells.end(), 1));
+		SweepEngine<int32_t, OutputPolicy_Simple<int32_t>, WindingPolicy_NonZero<>> engine(polygon);
+		engine.Process();
+		Polygon<int32_t> result = engine.Result();
+		errors += (GetArea(result) != covered);
+
+		Polygon<double> polygon_double;
+		for(size_t i = 0; i < polygon.loops.size(); ++i) {
+			for(size_t j = 0; j < polygon.GetLoopVertexCount(i); ++j) {
+				V v = polygon.GetLoopVertices(i)[j];
+				polygon_double.AddVertex(Vertex<double>(v.x, v.y));
+			}
+			polygon_double.AddLoopEnd(polygon.loops[i].weight);
+		}
+		SweepEngine<double, OutputPolicy_Simple<double>, WindingPolicy_NonZero<>> engine_double(polygon_double);
+		engine_double.Process();
+		Polygon<double> result_double = engine_double.Result();
+		errors += (result_double.vertices.size() != result.vertices.size());
+		for(size_t i = 0; i < result.vertices.size() && i < result_double.vertices.size(); ++i) {
+			errors += (result_double.vertices[i].x != double(result.vertices[i].x) || result_double.vertices[i].y != double(result.vertices[i].y));
+		}
+
+		for(V v : {V(100, 0), V(100, 10), V(110, 0)}) {
+			polygon.AddVertex(v);
+		}
+		polygon.AddLoopEnd(1);
+		engine.Reset(polygon);
+		engine.Process();
+		errors += (GetArea(engine.Result()) != covered + 50.0);
+	}
+	REQUIRE(errors == 0);
+
+}
+
+TEST_CASE("Polygon hatching", "[polymath]") {
+
+	// square with a hole
+	Polygon<int32_t> ring = MakeRectangle<int32_t>(5, 5, 95, 95);
+	ring.AddVertex(Vertex<int32_t>(35, 35));
+	ring.AddVertex(Vertex<int32_t>(65, 35));
+	ring.AddVertex(Vertex<int32_t>(65, 65));
+	ring.AddVertex(Vertex<int32_t>(35, 65));
+	ring.AddLoopEnd(1);
+	REQUIRE(SamePolyline(PolygonHatch(ring, 10.0, 0.5 * M_PI), Polyline<int32_t>({
+		{{10, 5}, {10, 95}}, {{20, 5}, {20, 95}}, {{30, 5}, {30, 95}},
+		{{40, 5}, {40, 35}}, {{40, 65}, {40, 95}}, {{50, 5}, {50, 35}}, {{50, 65}, {50, 95}}, {{60, 5}, {60, 35}}, {{60, 65}, {60, 95}},
+		{{70, 5}, {70, 95}}, {{80, 5}, {80, 95}}, {{90, 5}, {90, 95}},
+	})));
+	REQUIRE(SamePolyline(PolygonHatch(ring, 10.0, 0.5 * M_PI, true), Polyline<int32_t>({
+		{{10, 95}, {10, 5}}, {{20, 5}, {20, 95}}, {{30, 95}, {30, 5}},
+		{{40, 5}, {40, 35}}, {{40, 65}, {40, 95}}, {{50, 95}, {50, 65}}, {{50, 35}, {50, 5}}, {{60, 5}, {60, 35}}, {{60, 65}, {60, 95}},
+		{{70, 95}, {70, 5}}, {{80, 5}, {80, 95}}, {{90, 95}, {90, 5}},
+	})));
+
+	// compare with a brute force test (the vertices are never on a hatch line)
+	std::mt19937_64 rng(RANDOM_SEED);
+	uint32_t errors = 0;
+	for(uint32_t test = 0; test < 100; ++test) {
+		Polygon<int32_t> polygon;
+		for(uint32_t i = 0; i < 10; ++i) {
+			polygon.AddVertex(Vertex<int32_t>(int32_t(rng() % 100) * 2 - 99, int32_t(rng() % 200) - 100));
+		}
+		polygon.AddLoopEnd(1);
+		Polyline<int32_t> expected;
+		for(int32_t x = -90; x <= 90; x += 10) {
+			std::vector<std::pair<double, int32_t>> crossings;
+			for(size_t i = 0; i < polygon.vertices.size(); ++i) {
+				Vertex<int32_t> a = polygon.vertices[i], b = polygon.vertices[(i + 1) % polygon.vertices.size()];
+				if((a.x < x) != (b.x < x))
+					crossings.emplace_back(double(a.y) + double(b.y - a.y) * double(x - a.x) / double(b.x - a.x), (a.x < x)? 1 : -1);
+			}
+			std::sort(crossings.begin(), crossings.end());
+			int32_t winding = 0;
+			for(auto &crossing : crossings) {
+				if(winding == 0)
+					expected.AddVertex(Vertex<int32_t>(x, ConvertFromDouble<int32_t>(crossing.first)));
+				winding += crossing.second;
+				if(winding == 0) {
+					expected.AddVertex(Vertex<int32_t>(x, ConvertFromDouble<int32_t>(crossing.first)));
+					expected.AddPathEnd();
+				}
+			}
+		}
+		Polyline<int32_t> result = PolygonHatch(polygon, 10.0, 0.5 * M_PI);
+		bool same = (result.path_ends == expected.path_ends);
+		for(size_t i = 0; same && i < result.vertices.size(); ++i) {
+			same = (result.vertices[i].x == expected.vertices[i].x && std::abs(result.vertices[i].y - expected.vertices[i].y) <= 1);
+		}
+		errors += !same;
+	}
+	REQUIRE(errors == 0);
+
+}
+
+TEST_CASE("Bitmap tracing", "[polymath]") {
+
+	// a ring, a pixel that only touches it at a corner and a separate rectangle
+	const uint8_t mask[] = {
+		1, 1, 1, 0, 0, 0, 0,
+		1, 0, 1, 0, 0, 1, 1,
+		1, 1, 1, 0, 0, 1, 1,
+		0, 0, 0, 1, 0, 0, 0,
+	};
+	Polygon<int32_t> polygon = PolygonFromBitmap<int32_t>(mask, 7, 4, 7);
+	SweepEngine<int32_t, OutputPolicy_Measure<int32_t>, WindingPolicy_NonZero<>> engine(polygon);
+	engine.Process();
+	REQUIRE(engine.GetOutputPolicy().GetArea() == 13.0);
+	REQUIRE(polygon.loops.size() == 4);
+	REQUIRE(polygon.vertices.size() == 16);
+	std::vector<BitmapRun<int32_t>> runs = {{3, 3, 4}, {1, 5, 7}, {0, 0, 3}, {2, 5, 7}, {1, 0, 1}, {1, 2, 3}, {2, 0, 2}, {2, 1, 3}};
+	REQUIRE(PolygonFromRuns(runs).loops.size() == 4);
+	REQUIRE(PolygonFromRuns(runs).vertices.size() == 16);
+
+	// compare with the pixels of random bitmaps
+	std::mt19937_64 rng(RANDOM_SEED);
+	uint32_t errors = 0;
+	for(uint32_t test = 0; test < 50; ++test) {
+		std::vector<uint8_t> bitmap(20 * 20);
+		for(uint8_t &pixel : bitmap) {
+			pixel = (rng() % 3 != 0);
+		}
+		Polygon<double> traced = PolygonFromBitmap<double>(bitmap.data(), 20, 20, 20);
+		for(size_t y = 0; y < 20; ++y) {
+			for(size_t x = 0; x < 20; ++x) {
+				// clockwise loops have winding number -1
+				int64_t winding = PolygonPointWindingNumber(traced, Vertex<double>(double(x) + 0.5, double(y) + 0.5));
+				errors += (-winding != bitmap[y * 20 + x]);
+			}
+		}
+	}
+	REQUIRE(errors == 0);
+
+}
+
+TEST_CASE("Rasterization", "[polymath]") {
+	typedef OutputPolicy_Raster<double> Raster;
+
+	auto Render = [](const Polygon<double> &polygon, RasterMode mode) {
+		SweepEngine<double, Raster, WindingPolicy_NonZero<>> engine(polygon, Raster(4, 4, 0.0, 0.0, 4.0, 4.0, mode));
+		engine.Process();
+		return engine.GetOutputPolicy().ResultRaster();
+	};
+	auto Same = [](const std::vector<float> &raster, std::initializer_list<float> expected) {
+		if(raster.size() != expected.size())
+			return false;
+		size_t i = 0;
+		for(float value : expected) {
+			if(std::fabs(raster[i++] - value) > 1e-6f)
+				return false;
+		}
+		return true;
+	};
+
+	// a rectangle that covers parts of pixels, row 0 is at the bottom
+	Polygon<double> rectangle = MakeRectangle<double>(0.25, 0.25, 2.75, 1.75);
+	REQUIRE(Same(Render(rectangle, RASTERMODE_COVERAGE), {
+		0.5625f, 0.75f, 0.5625f, 0.0f,
+		0.5625f, 0.75f, 0.5625f, 0.0f,
+		0.0f, 0.0f, 0.0f, 0.0f,
+		0.0f, 0.0f, 0.0f, 0.0f,
+	}));
+	REQUIRE(Same(Render(rectangle, RASTERMODE_BINARY), {
+		1.0f, 1.0f, 1.0f, 0.0f,
+		1.0f, 1.0f, 1.0f, 0.0f,
+		0.0f, 0.0f, 0.0f, 0.0f,
+		0.0f, 0.0f, 0.0f, 0.0f,
+	}));
+
+	// a triangle with a diagonal edge through the pixel corners
+	Polygon<double> triangle;
+	triangle.AddVertex(Vertex<double>(0.0, 0.0));
+	triangle.AddVertex(Vertex<double>(0.0, 4.0));
+	triangle.AddVertex(Vertex<double>(4.0, 0.0));
+	triangle.AddLoopEnd(1);
+	REQUIRE(Same(Render(triangle, RASTERMODE_COVERAGE), {
+		1.0f, 1.0f, 1.0f, 0.5f,
+		1.0f, 1.0f, 0.5f, 0.0f,
+		1.0f, 0.5f, 0.0f, 0.0f,
+		0.5f, 0.0f, 0.0f, 0.0f,
+	}));
+
+	// a ring that extends beyond the raster, with a hole in the middle
+	Polygon<double> ring = MakeRectangle<double>(-1.0, -1.0, 5.0, 5.0);
+	for(Vertex<double> v : MakeRectangle<double>(3.0, 1.0, 1.0, 3.0).vertices) {
+		ring.AddVertex(v);
+	}
+	ring.AddLoopEnd(1);
+	for(RasterMode mode : {RASTERMODE_COVERAGE, RASTERMODE_BINARY}) {
+		REQUIRE(Same(Render(ring, mode), {
+			1.0f, 1.0f, 1.0f, 1.0f,
+			1.0f, 0.0f, 0.0f, 1.0f,
+			1.0f, 0.0f, 0.0f, 1.0f,
+			1.0f, 1.0f, 1.0f, 1.0f,
+		}));
+	}
+
+}
+
+TEST_CASE("Coordinate conversion", "[polymath]") {
+
+	// integers are rounded and clamped to the half range that the numerical engine supports
+	REQUIRE(ConvertFromDouble<int32_t>(2.4) == 2);
+	REQUIRE(ConvertFromDouble<int32_t>(-2.6) == -3);
+	REQUIRE(ConvertFromDouble<int32_t>(1e10) == INT32_MAX / 2);
+	REQUIRE(ConvertFromDouble<int32_t>(-1e10) == INT32_MIN / 2);
+	REQUIRE(ConvertFromDouble<int32_t>(double(INT32_MAX / 2) + 0.4) == INT32_MAX / 2);
+	REQUIRE(ConvertFromDouble<int64_t>(9.2e18) == INT64_MAX / 2);
+	REQUIRE(ConvertFromDouble<int64_t>(std::nextafter(std::ldexp(1.0, 62), 0.0)) == int64_t(std::nextafter(std::ldexp(1.0, 62), 0.0)));
+	REQUIRE(ConvertFromDouble<int64_t>(-std::ldexp(1.0, 63)) == INT64_MIN / 2);
+	REQUIRE(ConvertFromDouble<int16_t>(-40000.0) == INT16_MIN / 2);
+
+}
@@ -86,6 +86,105 @@ TEST_CASE("Wide multiplication (Multiply_64x64_128)", "[widemath]") {
 
 }
 
+TEST_CASE("Wide multiplication (Multiply_128x128_256)", "[widemath]") {
+
+	std::mt19937_64 rng(RANDOM_SEED);
+
+	// unsigned x signed
+	uint32_t errors1 = 0;
+	for(uint32_t i = 0; i < NUM_TESTS_RANDOM; ++i) {
+		uint64_t a0 = RandomU64(rng), a1 = RandomU64(rng), b0 = RandomU64(rng);
+		int64_t b1 = RandomS64(rng);
+		uint64_t m0, m1, m2;
+		int64_t m3;
+		WideMath::Multiply_128x128_256(a0, a1, b0, b1, m0, m1, m2, m3);
+		uint64_t r0 = 0, r1 = 0, r2 = 0, t0 = a0, t1 = a1, t2 = 0;
+		int64_t r3 = 0, t3 = 0;
+		for(uint32_t i = 0; i < 128; ++i) {
+			if(((i < 64)? b0 >> i : uint64_t(b1) >> (i - 64)) & 1) {
+				if(i == 127) {
+					WideMath::Subtract_256(r0, r1, r2, r3, t0, t1, t2, t3, r0, r1, r2, r3);
+				} else {
+					WideMath::Add_256(r0, r1, r2, r3, t0, t1, t2, t3, r0, r1, r2, r3);
+				}
+			}
+			WideMath::ShiftLeft_256_256(t0, t1, t2, t3, 1, t0, t1, t2, t3);
+		}
+		errors1 += (m0 != r0 || m1 != r1 || m2 != r2 || m3 != r3);
+	}
+	REQUIRE(errors1 == 0);
+
+	// signed x unsigned
+	uint32_t errors2 = 0;
+	for(uint32_t i = 0; i < NUM_TESTS_RANDOM; ++i) {
+		uint64_t a0 = RandomU64(rng), b0 = RandomU64(rng), b1 = RandomU64(rng);
+		int64_t a1 = RandomS64(rng);
+		uint64_t m0, m1, m2;
+		int64_t m3;
+		WideMath::Multiply_128x128_256(a0, a1, b0, b1, m0, m1, m2, m3);
+		uint64_t r0 = 0, r1 = 0, r2 = 0, t0 = a0, t1 = uint64_t(a1), t2 = uint64_t(a1 >> 63);
+		int64_t r3 = 0, t3 = a1 >> 63;
+		for(uint32_t i = 0; i < 128; ++i) {
+			if(((i < 64)? b0 >> i : b1 >> (i - 64)) & 1) {
+				WideMath::Add_256(r0, r1, r2, r3, t0, t1, t2, t3, r0, r1, r2, r3);
+			}
+			WideMath::ShiftLeft_256_256(t0, t1, t2, t3, 1, t0, t1, t2, t3);
+		}
+		errors2 += (m0 != r0 || m1 != r1 || m2 != r2 || m3 != r3);
+	}
+	REQUIRE(errors2 == 0);
+
+}
+
+TEST_CASE("Wide comparison (Compare*_256)", "[widemath]") {
+
+	std::mt19937_64 rng(RANDOM_SEED);
+
+	// unsigned (the high words are often equal so all words are compared)
+	uint32_t errors1 = 0;
+	for(uint32_t i = 0; i < NUM_TESTS_RANDOM; ++i) {
+		uint64_t a[4], b[4];
+		for(uint32_t j = 0; j < 4; ++j) {
+			a[j] = RandomU64(rng);
+			b[j] = (rng() & 1)? a[j] : RandomU64(rng);
+		}
+		int cmp = 0;
+		for(uint32_t j = 4; j-- > 0 && cmp == 0; ) {
+			cmp = (a[j] < b[j])? -1 : (a[j] > b[j])? 1 : 0;
+		}
+		errors1 += (WideMath::CompareEqual_256(a[0], a[1], a[2], a[3], b[0], b[1], b[2], b[3]) != (cmp == 0));
+		errors1 += (WideMath::CompareNotEqual_256(a[0], a[1], a[2], a[3], b[0], b[1], b[2], b[3]) != (cmp != 0));
+		errors1 += (WideMath::CompareLess_256(a[0], a[1], a[2], a[3], b[0], b[1], b[2], b[3]) != (cmp < 0));
+		errors1 += (WideMath::CompareGreaterEqual_256(a[0], a[1], a[2], a[3], b[0], b[1], b[2], b[3]) != (cmp >= 0));
+		errors1 += (WideMath::CompareGreater_256(a[0], a[1], a[2], a[3], b[0], b[1], b[2], b[3]) != (cmp > 0));
+		errors1 += (WideMath::CompareLessEqual_256(a[0], a[1], a[2], a[3], b[0], b[1], b[2], b[3]) != (cmp <= 0));
+	}
+	REQUIRE(errors1 == 0);
+
+	// signed
+	uint32_t errors2 = 0;
+	for(uint32_t i = 0; i < NUM_TESTS_RANDOM; ++i) {
+		uint64_t a[3], b[3];
+		for(uint32_t j = 0; j < 3; ++j) {
+			a[j] = RandomU64(rng);
+			b[j] = (rng() & 1)? a[j] : RandomU64(rng);
+		}
+		int64_t a3 = RandomS64(rng), b3 = (rng() & 1)? a3 : RandomS64(rng);
+		int cmp = (a3 < b3)? -1 : (a3 > b3)? 1 : 0;
+		for(uint32_t j = 3; j-- > 0 && cmp == 0; ) {
+			cmp = (a[j] < b[j])? -1 : (a[j] > b[j])? 1 : 0;
+		}
+		errors2 += (WideMath::CompareEqual_256(a[0], a[1], a[2], a3, b[0], b[1], b[2], b3) != (cmp == 0));
+		errors2 += (WideMath::CompareNotEqual_256(a[0], a[1], a[2], a3, b[0], b[1], b[2], b3) != (cmp != 0));
+		errors2 += (WideMath::CompareLess_256(a[0], a[1], a[2], a3, b[0], b[1], b[2], b3) != (cmp < 0));
+		errors2 += (WideMath::CompareGreaterEqual_256(a[0], a[1], a[2], a3, b[0], b[1], b[2], b3) != (cmp >= 0));
+		errors2 += (WideMath::CompareGreater_256(a[0], a[1], a[2], a3, b[0], b[1], b[2], b3) != (cmp > 0));
+		errors2 += (WideMath::CompareLessEqual_256(a[0], a[1], a[2], a3, b[0], b[1], b[2], b3) != (cmp <= 0));
+	}
+	REQUIRE(errors2 == 0);
+
+}
+
 TEST_CASE("Wide division (DivideFloor_128x64_64)", "[widemath]") {
 
 	std::mt19937_64 rng(RANDOM_SEED);
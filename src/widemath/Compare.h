@@ -20,6 +20,14 @@ inline bool CompareEqual_192(uint64_t a0, uint64_t a1, int64_t a2, uint64_t b0,
 	return (a0 == b0 && a1 == b1 && a2 == b2);
 }
 
+inline bool CompareEqual_256(uint64_t a0, uint64_t a1, uint64_t a2, uint64_t a3, uint64_t b0, uint64_t b1, uint64_t b2, uint64_t b3) {
+	return (a0 == b0 && a1 == b1 && a2 == b2 && a3 == b3);
+}
+
+inline bool CompareEqual_256(uint64_t a0, uint64_t a1, uint64_t a2, int64_t a3, uint64_t b0, uint64_t b1, uint64_t b2, int64_t b3) {
+	return (a0 == b0 && a1 == b1 && a2 == b2 && a3 == b3);
+}
+
 inline bool CompareNotEqual_128(uint64_t a0, uint64_t a1, uint64_t b0, uint64_t b1) {
 	return !CompareEqual_128(a0, a1, b0, b1);
 }
@@ -36,6 +44,14 @@ inline bool CompareNotEqual_192(uint64_t a0, uint64_t a1, int64_t a2, uint64_t b
 	return !CompareEqual_192(a0, a1, a2, b0, b1, b2);
 }
 
+inline bool CompareNotEqual_256(uint64_t a0, uint64_t a1, uint64_t a2, uint64_t a3, uint64_t b0, uint64_t b1, uint64_t b2, uint64_t b3) {
+	return !CompareEqual_256(a0, a1, a2, a3, b0, b1, b2, b3);
+}
+
+inline bool CompareNotEqual_256(uint64_t a0, uint64_t a1, uint64_t a2, int64_t a3, uint64_t b0, uint64_t b1, uint64_t b2, int64_t b3) {
+	return !CompareEqual_256(a0, a1, a2, a3, b0, b1, b2, b3);
+}
+
 inline bool CompareLess_128(uint64_t a0, uint64_t a1, uint64_t b0, uint64_t b1) {
 #if WIDEMATH_USE_ASM && defined(__GNUC__) && defined(__x86_64__)
 	bool r;
@@ -106,6 +122,44 @@ inline bool CompareLess_192(uint64_t a0, uint64_t a1, int64_t a2, uint64_t b0, u
 #endif
 }
 
+inline bool CompareLess_256(uint64_t a0, uint64_t a1, uint64_t a2, uint64_t a3, uint64_t b0, uint64_t b1, uint64_t b2, uint64_t b3) {
+#if WIDEMATH_USE_ASM && defined(__GNUC__) && defined(__x86_64__)
+	bool r;
+	asm(
+		"cmpq %8, %4 \n\t"
+		"sbbq %9, %5 \n\t"
+		"sbbq %10, %6 \n\t"
+		"sbbq %11, %7"
+		ASM_FLAG_SET("b", "%0")
+		: ASM_FLAG_OUT("b", r), "=&r" (a1), "=&r" (a2), "=&r" (a3)
+		: "r" (a0), "1" (a1), "2" (a2), "3" (a3), "erm" (b0), "erm" (b1), "erm" (b2), "erm" (b3)
+		: "cc"
+	);
+	return r;
+#else
+	return (a3 < b3 || (a3 == b3 && (a2 < b2 || (a2 == b2 && (a1 < b1 || (a1 == b1 && a0 < b0))))));
+#endif
+}
+
+inline bool CompareLess_256(uint64_t a0, uint64_t a1, uint64_t a2, int64_t a3, uint64_t b0, uint64_t b1, uint64_t b2, int64_t b3) {
+#if WIDEMATH_USE_ASM && defined(__GNUC__) && defined(__x86_64__)
+	bool r;
+	asm(
+		"cmpq %8, %4 \n\t"
+		"sbbq %9, %5 \n\t"
+		"sbbq %10, %6 \n\t"
+		"sbbq %11, %7"
+		ASM_FLAG_SET("l", "%0")
+		: ASM_FLAG_OUT("l", r), "=&r" (a1), "=&r" (a2), "=&r" (a3)
+		: "r" (a0), "1" (a1), "2" (a2), "3" (a3), "erm" (b0), "erm" (b1), "erm" (b2), "erm" (b3)
+		: "cc"
+	);
+	return r;
+#else
+	return (a3 < b3 || (a3 == b3 && (a2 < b2 || (a2 == b2 && (a1 < b1 || (a1 == b1 && a0 < b0))))));
+#endif
+}
+
 inline bool CompareGreaterEqual_128(uint64_t a0, uint64_t a1, uint64_t b0, uint64_t b1) {
 #if WIDEMATH_USE_ASM && defined(__GNUC__) && defined(__x86_64__)
 	bool r;
@@ -176,6 +230,44 @@ inline bool CompareGreaterEqual_192(uint64_t a0, uint64_t a1, int64_t a2, uint64
 #endif
 }
 
+inline bool CompareGreaterEqual_256(uint64_t a0, uint64_t a1, uint64_t a2, uint64_t a3, uint64_t b0, uint64_t b1, uint64_t b2, uint64_t b3) {
+#if WIDEMATH_USE_ASM && defined(__GNUC__) && defined(__x86_64__)
+	bool r;
+	asm(
+		"cmpq %8, %4 \n\t"
+		"sbbq %9, %5 \n\t"
+		"sbbq %10, %6 \n\t"
+		"sbbq %11, %7"
+		ASM_FLAG_SET("ae", "%0")
+		: ASM_FLAG_OUT("ae", r), "=&r" (a1), "=&r" (a2), "=&r" (a3)
+		: "r" (a0), "1" (a1), "2" (a2), "3" (a3), "erm" (b0), "erm" (b1), "erm" (b2), "erm" (b3)
+		: "cc"
+	);
+	return r;
+#else
+	return (a3 > b3 || (a3 == b3 && (a2 > b2 || (a2 == b2 && (a1 > b1 || (a1 == b1 && a0 >= b0))))));
+#endif
+}
+
+inline bool CompareGreaterEqual_256(uint64_t a0, uint64_t a1, uint64_t a2, int64_t a3, uint64_t b0, uint64_t b1, uint64_t b2, int64_t b3) {
+#if WIDEMATH_USE_ASM && defined(__GNUC__) && defined(__x86_64__)
+	bool r;
+	asm(
+		"cmpq %8, %4 \n\t"
+		"sbbq %9, %5 \n\t"
+		"sbbq %10, %6 \n\t"
+		"sbbq %11, %7"
+		ASM_FLAG_SET("ge", "%0")
+		: ASM_FLAG_OUT("ge", r), "=&r" (a1), "=&r" (a2), "=&r" (a3)
+		: "r" (a0), "1" (a1), "2" (a2), "3" (a3), "erm" (b0), "erm" (b1), "erm" (b2), "erm" (b3)
+		: "cc"
+	);
+	return r;
+#else
+	return (a3 > b3 || (a3 == b3 && (a2 > b2 || (a2 == b2 && (a1 > b1 || (a1 == b1 && a0 >= b0))))));
+#endif
+}
+
 inline bool CompareGreater_128(uint64_t a0, uint64_t a1, uint64_t b0, uint64_t b1) {
 	return CompareLess_128(b0, b1, a0, a1);
 }
@@ -192,6 +284,14 @@ inline bool CompareGreater_192(uint64_t a0, uint64_t a1, int64_t a2, uint64_t b0
 	return CompareLess_192(b0, b1, b2, a0, a1, a2);
 }
 
+inline bool CompareGreater_256(uint64_t a0, uint64_t a1, uint64_t a2, uint64_t a3, uint64_t b0, uint64_t b1, uint64_t b2, uint64_t b3) {
+	return CompareLess_256(b0, b1, b2, b3, a0, a1, a2, a3);
+}
+
+inline bool CompareGreater_256(uint64_t a0, uint64_t a1, uint64_t a2, int64_t a3, uint64_t b0, uint64_t b1, uint64_t b2, int64_t b3) {
+	return CompareLess_256(b0, b1, b2, b3, a0, a1, a2, a3);
+}
+
 inline bool CompareLessEqual_128(uint64_t a0, uint64_t a1, uint64_t b0, uint64_t b1) {
 	return CompareGreaterEqual_128(b0, b1, a0, a1);
 }
@@ -208,4 +308,12 @@ inline bool CompareLessEqual_192(uint64_t a0, uint64_t a1, int64_t a2, uint64_t
 	return CompareGreaterEqual_192(b0, b1, b2, a0, a1, a2);
 }
 
+inline bool CompareLessEqual_256(uint64_t a0, uint64_t a1, uint64_t a2, uint64_t a3, uint64_t b0, uint64_t b1, uint64_t b2, uint64_t b3) {
+	return CompareGreaterEqual_256(b0, b1, b2, b3, a0, a1, a2, a3);
+}
+
+inline bool CompareLessEqual_256(uint64_t a0, uint64_t a1, uint64_t a2, int64_t a3, uint64_t b0, uint64_t b1, uint64_t b2, int64_t b3) {
+	return CompareGreaterEqual_256(b0, b1, b2, b3, a0, a1, a2, a3);
+}
+
 }
@@ -3,6 +3,7 @@
 #include "Common.h"
 
 #include "Add.h"
+#include "Subtract.h"
 
 namespace WideMath {
 
@@ -113,4 +114,16 @@ inline void Multiply_128x128_256(uint64_t a0, int64_t a1, uint64_t b0, int64_t b
 	Add_192(u1, u2, u3, t001, t011, 0, m1, m2, m3);
 }
 
+inline void Multiply_128x128_256(uint64_t a0, uint64_t a1, uint64_t b0, int64_t b1, uint64_t &m0, uint64_t &m1, uint64_t &m2, int64_t &m3) {
+	uint64_t um2, um3;
+	Multiply_128x128_256(a0, a1, b0, uint64_t(b1), m0, m1, um2, um3);
+	uint64_t s = uint64_t(b1 >> 63);
+	Subtract_128(um2, um3, a0 & s, a1 & s, m2, um3);
+	m3 = int64_t(um3);
+}
+
+inline void Multiply_128x128_256(uint64_t a0, int64_t a1, uint64_t b0, uint64_t b1, uint64_t &m0, uint64_t &m1, uint64_t &m2, int64_t &m3) {
+	Multiply_128x128_256(b0, b1, a0, a1, m0, m1, m2, m3);
+}
+
 }